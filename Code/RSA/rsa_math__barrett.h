@@ -0,0 +1,208 @@
+#pragma once
+
+#include "rsa__debug.h"
+#include "rsa_math__big_uint.h"
+#include "rsa_math__utils.h"
+#include "rsa_math__workspace.h"
+#include "rsa_math_ops__blocks.h"
+#include "rsa_math_ops__multiplication.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace rsa
+{
+
+	namespace math
+	{
+
+		// precomputed values for barrett reduction modulo any non-zero number m (of k blocks).
+		// the reciprocal mu = floor(b^2k / m) is calculated once, after which values less than b^2k
+		// (e.g. the product of two values less than m) are reduced with two multiplications instead of a division.
+		template<class block_t>
+		class barrett_context
+		{
+		public:
+
+			using block_type = block_t;
+			using value_type = big_uint<block_t>;
+
+#pragma region constructors
+
+			explicit barrett_context(value_type modulus);
+
+#pragma endregion
+
+#pragma region general
+
+			value_type const& modulus() const;
+
+#pragma endregion
+
+#pragma region math
+
+			// a = a mod m. values of b^2k or more fall back to ops::mod_assign. temporary storage is taken from ws.
+			void reduce(value_type& a, workspace<block_t>& ws = default_workspace<block_t>()) const;
+
+			value_type mod(value_type a) const;
+
+			// a = a * b mod m. a and b must be less than m. a and b may be the same object.
+			void mul_assign(value_type& a, value_type const& b, workspace<block_t>& ws = default_workspace<block_t>()) const;
+
+			// a = a * a mod m. a must be less than m.
+			void sqr_assign(value_type& a, workspace<block_t>& ws = default_workspace<block_t>()) const;
+
+			value_type mul(value_type a, value_type const& b) const;
+			value_type sqr(value_type a) const;
+
+#pragma endregion
+
+		private:
+
+			value_type m_modulus;
+			value_type m_mu; // floor(b^2k / m)
+		};
+
+#pragma region members - constructors
+
+		template<class block_t>
+		barrett_context<block_t>::barrett_context(value_type modulus):
+			m_modulus(std::move(modulus)),
+			m_mu(m_modulus.get_allocator())
+		{
+			if (m_modulus.is_zero())
+				throw std::invalid_argument("barrett modulus cannot be zero.");
+
+			auto const k = m_modulus.data().size();
+
+			m_mu = (value_type(1u, m_modulus.get_allocator()) <<= (2u * k * utils::digits<block_t>()));
+			m_mu /= m_modulus;
+
+			debug::die_if(m_mu.data().size() > k + 2u); // (k + 2 only when m = b^(k - 1))
+		}
+
+#pragma endregion
+
+#pragma region members - general
+
+		template<class block_t>
+		typename barrett_context<block_t>::value_type const& barrett_context<block_t>::modulus() const
+		{
+			return m_modulus;
+		}
+
+#pragma endregion
+
+#pragma region members - math
+
+		template<class block_t>
+		void barrett_context<block_t>::reduce(value_type& a, workspace<block_t>& ws) const
+		{
+			if (a < m_modulus)
+				return;
+
+			auto const k = m_modulus.data().size();
+			auto const& x = a.data();
+
+			if (x.size() > 2u * k)
+			{
+				ops::mod_assign(a, m_modulus, ws);
+				return;
+			}
+
+			auto const& m = m_modulus.data();
+			auto const& mu = m_mu.data();
+
+			// below the toom-3 threshold, only the blocks of the products that are actually needed are calculated (in about half the time
+			// of a basecase multiplication, which beats karatsuba at these sizes). otherwise, the full products are calculated.
+			auto const truncate = (k < ops::thresholds().toom3 && k <= utils::max<block_t>());
+
+			// q = floor(floor(x / b^(k - 1)) * mu / b^(k + 1)). this is at most 2 less than floor(x / m).
+			// (3 less when truncating, as the low partial products of the estimate add less than (k - 1) * b^k < b^(k + 1).)
+			auto const q1 = x.data() + (k - 1u);
+			auto const q1_size = x.size() - (k - 1u);
+
+			auto frame = typename workspace<block_t>::frame(ws);
+
+			auto const q2_size = q1_size + mu.size();
+			auto const q2 = frame.allocate(q2_size);
+
+			if (truncate)
+				ops::blocks::mul_high_basecase(q2, q1, q1_size, mu.data(), mu.size(), k - 1u);
+			else
+				ops::blocks::mul(q2, q1, q1_size, mu.data(), mu.size(), ws);
+
+			auto const q3 = q2 + std::min(k + 1u, q2_size);
+			auto const q3_size = ops::blocks::normalized_size(q3, q2_size - std::min(k + 1u, q2_size));
+
+			// r = (x - q * m) mod b^(k + 1). the true remainder is less than 4m < b^(k + 1), so only the low blocks are needed.
+			auto const r = frame.allocate(k + 1u);
+			std::copy(x.begin(), x.begin() + std::min(x.size(), k + 1u), r);
+
+			if (q3_size != 0u)
+			{
+				auto const qm = frame.allocate(q3_size + k);
+
+				// (q3 * m) mod b^(k + 1)
+				if (truncate)
+					ops::blocks::mul_low_basecase(qm, q3, q3_size, m.data(), k, k + 1u);
+				else
+					ops::blocks::mul(qm, q3, q3_size, m.data(), k, ws);
+
+				ops::blocks::sub_n(r, r, qm, k + 1u);
+			}
+
+			while (ops::blocks::cmp(r, k + 1u, m.data(), k) >= 0)
+				ops::blocks::sub(r, r, k + 1u, m.data(), k);
+
+			a.data().assign(r, r + (k + 1u));
+			utils::trim(a);
+		}
+
+		template<class block_t>
+		typename barrett_context<block_t>::value_type barrett_context<block_t>::mod(value_type a) const
+		{
+			reduce(a);
+			return a;
+		}
+
+		template<class block_t>
+		void barrett_context<block_t>::mul_assign(value_type& a, value_type const& b, workspace<block_t>& ws) const
+		{
+			debug::die_if(a >= m_modulus);
+			debug::die_if(b >= m_modulus);
+
+			ops::mul_assign(a, b, ws);
+			reduce(a, ws);
+		}
+
+		template<class block_t>
+		void barrett_context<block_t>::sqr_assign(value_type& a, workspace<block_t>& ws) const
+		{
+			debug::die_if(a >= m_modulus);
+
+			ops::sqr_assign(a, ws);
+			reduce(a, ws);
+		}
+
+		template<class block_t>
+		typename barrett_context<block_t>::value_type barrett_context<block_t>::mul(value_type a, value_type const& b) const
+		{
+			mul_assign(a, b);
+			return a;
+		}
+
+		template<class block_t>
+		typename barrett_context<block_t>::value_type barrett_context<block_t>::sqr(value_type a) const
+		{
+			sqr_assign(a);
+			return a;
+		}
+
+#pragma endregion
+
+	} // math
+
+} // rsa
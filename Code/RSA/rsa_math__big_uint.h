@@ -1,34 +1,34 @@
 #pragma once
 
 #include "rsa__debug.h"
+#include "rsa_math__big_uint_view.h"
+#include "rsa_math__small_vector.h"
 #include "rsa_math__utils.h"
 #include "rsa_math_ops__operations.h"
 
 #include <algorithm>
 #include <cstdint>
+#include <memory_resource>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+// numbers with up to this many blocks are stored inside the big_uint, without allocating.
+// set to 0 to store all numbers in a std::vector.
+#ifndef RSA_MATH_BIG_UINT_INLINE_BLOCKS
+#define RSA_MATH_BIG_UINT_INLINE_BLOCKS 4
+#endif
+
 namespace rsa
 {
 
 	namespace math
 	{
 
-		template<class block_t>
-		struct block_traits;
-
-		template<>
-		struct block_traits<std::uint8_t> { using double_block_type = std::uint16_t; };
-
-		template<>
-		struct block_traits<std::uint16_t> { using double_block_type = std::uint32_t; };
-
-		template<>
-		struct block_traits<std::uint32_t> { using double_block_type = std::uint64_t; };
-
-
+		// block storage is obtained from a std::pmr::memory_resource (the default resource, unless one is given on construction).
+		// copies use the same resource as the original (unlike std::pmr containers), so the temporaries created by
+		// the math operations and functions use the resource of their operands. assignment doesn't change the resource.
 		template<class block_t>
 		class big_uint
 		{
@@ -36,7 +36,10 @@ namespace rsa
 
 			using block_type = block_t;
 			using double_block_type = typename block_traits<block_type>::double_block_type;
-			using data_type = std::vector<block_type>;
+			using allocator_type = std::pmr::polymorphic_allocator<block_type>;
+			using data_type = std::conditional_t<(RSA_MATH_BIG_UINT_INLINE_BLOCKS == 0),
+				std::vector<block_type, allocator_type>,
+				small_vector<block_type, std::size_t{ RSA_MATH_BIG_UINT_INLINE_BLOCKS == 0 ? 1 : RSA_MATH_BIG_UINT_INLINE_BLOCKS }, allocator_type>>;
 			using block_index_type = std::size_t;
 			using bit_index_type = std::size_t;
 
@@ -47,19 +50,25 @@ namespace rsa
 #pragma region constructors
 
 			big_uint();
+			explicit big_uint(allocator_type const& allocator);
 
-			template<class uint_t>
-			explicit big_uint(uint_t n);
+			template<class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			explicit big_uint(uint_t n, allocator_type const& allocator = allocator_type());
 
-			big_uint(std::initializer_list<block_type> block_values);
+			big_uint(std::initializer_list<block_type> block_values, allocator_type const& allocator = allocator_type());
 
-			explicit big_uint(block_index_type block_count, block_type block_value);
+			explicit big_uint(block_index_type block_count, block_type block_value, allocator_type const& allocator = allocator_type());
 
 			template<class inputit_t>
-			explicit big_uint(inputit_t first, inputit_t last);
+			explicit big_uint(inputit_t first, inputit_t last, allocator_type const& allocator = allocator_type());
+
+			// copies the viewed blocks.
+			explicit big_uint(big_uint_view<block_type> n, allocator_type const& allocator = allocator_type());
 
-			big_uint(big_uint const&) = default;
+			big_uint(big_uint const& other);
+			big_uint(big_uint const& other, allocator_type const& allocator);
 			big_uint(big_uint&&) = default;
+			big_uint(big_uint&& other, allocator_type const& allocator);
 
 #pragma endregion
 
@@ -85,25 +94,28 @@ namespace rsa
 			void flip_bit(bit_index_type i);
 
 			bit_index_type get_most_significant_bit() const;
+			bit_index_type get_least_significant_bit() const;
 
 			data_type& data();
 			data_type const& data() const;
 
+			allocator_type get_allocator() const;
+
 #pragma endregion
 
 #pragma region bitwise operators
 
-			big_uint& operator&=(big_uint const& b);
+			big_uint& operator&=(big_uint_view<block_type> b);
 
 			template<class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 			big_uint& operator&=(uint_t n);
 
-			big_uint& operator|=(big_uint const& b);
+			big_uint& operator|=(big_uint_view<block_type> b);
 
 			template<class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 			big_uint& operator|=(uint_t n);
 
-			big_uint& operator^=(big_uint const& b);
+			big_uint& operator^=(big_uint_view<block_type> b);
 
 			template<class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 			big_uint& operator^=(uint_t n);
@@ -115,27 +127,27 @@ namespace rsa
 
 #pragma region math operators
 
-			big_uint& operator+=(big_uint const& b);
+			big_uint& operator+=(big_uint_view<block_type> b);
 
 			template<class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 			big_uint& operator+=(uint_t n);
 
-			big_uint& operator-=(big_uint const& b);
+			big_uint& operator-=(big_uint_view<block_type> b);
 
 			template<class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 			big_uint& operator-=(uint_t n);
 
-			big_uint& operator*=(big_uint const& b);
+			big_uint& operator*=(big_uint_view<block_type> b);
 
 			template<class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 			big_uint& operator*=(uint_t n);
 
-			big_uint& operator/=(big_uint b);
+			big_uint& operator/=(big_uint_view<block_type> b);
 
 			template<class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 			big_uint& operator/=(uint_t n);
 
-			big_uint& operator%=(big_uint b);
+			big_uint& operator%=(big_uint_view<block_type> b);
 
 			template<class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 			big_uint& operator%=(uint_t n);
@@ -157,6 +169,10 @@ namespace rsa
 		using big_uint_16 = big_uint<std::uint16_t>;
 		using big_uint_32 = big_uint<std::uint32_t>;
 
+#if defined(__SIZEOF_INT128__)
+		using big_uint_64 = big_uint<std::uint64_t>;
+#endif
+
 #pragma region members - construct
 
 		template<class block_t>
@@ -166,9 +182,16 @@ namespace rsa
 		}
 
 		template<class block_t>
-		template<class uint_t>
-		big_uint<block_t>::big_uint(uint_t n):
-			big_uint()
+		big_uint<block_t>::big_uint(allocator_type const& allocator):
+			m_data(allocator)
+		{
+
+		}
+
+		template<class block_t>
+		template<class uint_t, typename>
+		big_uint<block_t>::big_uint(uint_t n, allocator_type const& allocator):
+			big_uint(allocator)
 		{
 			static_assert(utils::is_uint_v<uint_t>, "`uint_t` must be an unsigned integer.");
 
@@ -188,27 +211,55 @@ namespace rsa
 		}
 
 		template<class block_t>
-		big_uint<block_t>::big_uint(std::initializer_list<block_type> block_values):
-			m_data(block_values)
+		big_uint<block_t>::big_uint(std::initializer_list<block_type> block_values, allocator_type const& allocator):
+			m_data(block_values, allocator)
 		{
 			utils::trim(*this);
 		}
 
 		template<class block_t>
-		big_uint<block_t>::big_uint(block_index_type block_count, block_type block_value):
-			m_data(block_count, block_value)
+		big_uint<block_t>::big_uint(block_index_type block_count, block_type block_value, allocator_type const& allocator):
+			m_data(block_count, block_value, allocator)
 		{
 			utils::trim(*this);
 		}
 
 		template<class block_t>
 		template<class inputit_t>
-		big_uint<block_t>::big_uint(inputit_t first, inputit_t last):
-			m_data(first, last)
+		big_uint<block_t>::big_uint(inputit_t first, inputit_t last, allocator_type const& allocator):
+			m_data(first, last, allocator)
 		{
 			utils::trim(*this);
 		}
 
+		template<class block_t>
+		big_uint<block_t>::big_uint(big_uint_view<block_type> n, allocator_type const& allocator):
+			m_data(n.data().begin(), n.data().end(), allocator)
+		{
+
+		}
+
+		template<class block_t>
+		big_uint<block_t>::big_uint(big_uint const& other):
+			m_data(other.m_data, other.get_allocator())
+		{
+
+		}
+
+		template<class block_t>
+		big_uint<block_t>::big_uint(big_uint const& other, allocator_type const& allocator):
+			m_data(other.m_data, allocator)
+		{
+
+		}
+
+		template<class block_t>
+		big_uint<block_t>::big_uint(big_uint&& other, allocator_type const& allocator):
+			m_data(std::move(other.m_data), allocator)
+		{
+
+		}
+
 #pragma endregion
 
 #pragma region members - general
@@ -307,6 +358,29 @@ namespace rsa
 			return bit_index_type{ count + (m_data.size() - 1u) * utils::digits<block_type>() };
 		}
 
+		template<class block_t>
+		typename big_uint<block_t>::bit_index_type big_uint<block_t>::get_least_significant_bit() const
+		{
+			if (is_zero())
+				throw std::logic_error("number must not be zero.");
+
+			auto i = std::size_t{ 0 };
+
+			while (m_data[i] == 0u)
+				++i;
+
+			auto block = m_data[i];
+			auto count = std::uint8_t{ 0u };
+
+			while ((block & 1u) == 0u)
+			{
+				++count;
+				block >>= 1u;
+			}
+
+			return bit_index_type{ count + i * utils::digits<block_type>() };
+		}
+
 		template<class block_t>
 		typename big_uint<block_t>::data_type& big_uint<block_t>::data()
 		{
@@ -319,6 +393,12 @@ namespace rsa
 			return m_data;
 		}
 
+		template<class block_t>
+		typename big_uint<block_t>::allocator_type big_uint<block_t>::get_allocator() const
+		{
+			return m_data.get_allocator();
+		}
+
 #pragma endregion
 
 #pragma region members - assignment
@@ -327,7 +407,9 @@ namespace rsa
 		template<class uint_t, typename>
 		big_uint<block_t>& big_uint<block_t>::operator=(uint_t n)
 		{
-			return (*this = big_uint(n));
+			auto const b = utils::to_blocks<block_t>(n);
+			m_data.assign(b.blocks.begin(), b.blocks.begin() + b.size);
+			return *this;
 		}
 
 #pragma endregion
@@ -335,7 +417,7 @@ namespace rsa
 #pragma region members - bitwise operators
 
 		template<class block_t>
-		big_uint<block_t>& big_uint<block_t>::operator&=(big_uint const& b)
+		big_uint<block_t>& big_uint<block_t>::operator&=(big_uint_view<block_type> b)
 		{
 			ops::bit_and_assign(*this, b);
 			return *this;
@@ -345,11 +427,12 @@ namespace rsa
 		template<class uint_t, typename>
 		big_uint<block_t>& big_uint<block_t>::operator&=(uint_t n)
 		{
-			return operator&=(big_uint(n));
+			ops::bit_and_assign(*this, n);
+			return *this;
 		}
 
 		template<class block_t>
-		big_uint<block_t>& big_uint<block_t>::operator|=(big_uint const& b)
+		big_uint<block_t>& big_uint<block_t>::operator|=(big_uint_view<block_type> b)
 		{
 			ops::bit_or_assign(*this, b);
 			return *this;
@@ -359,11 +442,12 @@ namespace rsa
 		template<class uint_t, typename>
 		big_uint<block_t>& big_uint<block_t>::operator|=(uint_t n)
 		{
-			return operator|=(big_uint(n));
+			ops::bit_or_assign(*this, n);
+			return *this;
 		}
 
 		template<class block_t>
-		big_uint<block_t>& big_uint<block_t>::operator^=(big_uint const& b)
+		big_uint<block_t>& big_uint<block_t>::operator^=(big_uint_view<block_type> b)
 		{
 			ops::bit_xor_assign(*this, b);
 			return *this;
@@ -373,7 +457,8 @@ namespace rsa
 		template<class uint_t, typename>
 		big_uint<block_t>& big_uint<block_t>::operator^=(uint_t n)
 		{
-			return operator^=(big_uint(n));
+			ops::bit_xor_assign(*this, n);
+			return *this;
 		}
 
 		template<class block_t>
@@ -395,7 +480,7 @@ namespace rsa
 #pragma region members - math operators
 
 		template<class block_t>
-		big_uint<block_t>& big_uint<block_t>::operator+=(big_uint const& b)
+		big_uint<block_t>& big_uint<block_t>::operator+=(big_uint_view<block_type> b)
 		{
 			ops::add_assign(*this, b);
 			return *this;
@@ -405,11 +490,12 @@ namespace rsa
 		template<class uint_t, typename>
 		big_uint<block_t>& big_uint<block_t>::operator+=(uint_t n)
 		{
-			return operator+=(big_uint(n));
+			ops::add_assign(*this, n);
+			return *this;
 		}
 
 		template<class block_t>
-		big_uint<block_t>& big_uint<block_t>::operator-=(big_uint const& b)
+		big_uint<block_t>& big_uint<block_t>::operator-=(big_uint_view<block_type> b)
 		{
 			ops::sub_assign(*this, b);
 			return *this;
@@ -419,11 +505,12 @@ namespace rsa
 		template<class uint_t, typename>
 		big_uint<block_t>& big_uint<block_t>::operator-=(uint_t n)
 		{
-			return operator-=(big_uint(n));
+			ops::sub_assign(*this, n);
+			return *this;
 		}
 
 		template<class block_t>
-		big_uint<block_t>& big_uint<block_t>::operator*=(big_uint const& b)
+		big_uint<block_t>& big_uint<block_t>::operator*=(big_uint_view<block_type> b)
 		{
 			ops::mul_assign(*this, b);
 			return *this;
@@ -433,11 +520,12 @@ namespace rsa
 		template<class uint_t, typename>
 		big_uint<block_t>& big_uint<block_t>::operator*=(uint_t n)
 		{
-			return operator*=(big_uint(n));
+			ops::mul_assign(*this, n);
+			return *this;
 		}
 
 		template<class block_t>
-		big_uint<block_t>& big_uint<block_t>::operator/=(big_uint b)
+		big_uint<block_t>& big_uint<block_t>::operator/=(big_uint_view<block_type> b)
 		{
 			ops::div_assign(*this, b);
 			return *this;
@@ -447,11 +535,12 @@ namespace rsa
 		template<class uint_t, typename>
 		big_uint<block_t>& big_uint<block_t>::operator/=(uint_t n)
 		{
-			return operator/=(big_uint(n));
+			ops::div_assign(*this, n);
+			return *this;
 		}
 
 		template<class block_t>
-		big_uint<block_t>& big_uint<block_t>::operator%=(big_uint b)
+		big_uint<block_t>& big_uint<block_t>::operator%=(big_uint_view<block_type> b)
 		{
 			ops::mod_assign(*this, b);
 			return *this;
@@ -461,7 +550,8 @@ namespace rsa
 		template<class uint_t, typename>
 		big_uint<block_t>& big_uint<block_t>::operator%=(uint_t n)
 		{
-			return operator%=(big_uint(n));
+			ops::mod_assign(*this, n);
+			return *this;
 		}
 
 		template<class block_t>
@@ -505,13 +595,13 @@ namespace rsa
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		bool operator==(big_uint<block_t> const& a, uint_t b)
 		{
-			return (a == big_uint<block_t>(b));
+			return (ops::cmp(a, b) == 0);
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		bool operator==(uint_t a, big_uint<block_t> const& b)
 		{
-			return (big_uint<block_t>(a) == b);
+			return (0 == ops::cmp(b, a));
 		}
 
 		template<class block_t>
@@ -523,13 +613,13 @@ namespace rsa
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		bool operator!=(big_uint<block_t> const& a, uint_t b)
 		{
-			return (a != big_uint<block_t>(b));
+			return (ops::cmp(a, b) != 0);
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		bool operator!=(uint_t a, big_uint<block_t> const& b)
 		{
-			return (big_uint<block_t>(a) != b);
+			return (0 != ops::cmp(b, a));
 		}
 
 		template<class block_t>
@@ -547,13 +637,13 @@ namespace rsa
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		bool operator<(big_uint<block_t> const& a, uint_t b)
 		{
-			return (a < big_uint<block_t>(b));
+			return (ops::cmp(a, b) < 0);
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		bool operator<(uint_t a, big_uint<block_t> const& b)
 		{
-			return (big_uint<block_t>(a) < b);
+			return (0 < ops::cmp(b, a));
 		}
 
 		template<class block_t>
@@ -565,13 +655,13 @@ namespace rsa
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		bool operator>(big_uint<block_t> const& a, uint_t b)
 		{
-			return (a > big_uint<block_t>(b));
+			return (ops::cmp(a, b) > 0);
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		bool operator>(uint_t a, big_uint<block_t> const& b)
 		{
-			return (big_uint<block_t>(a) > b);
+			return (0 > ops::cmp(b, a));
 		}
 
 		template<class block_t>
@@ -583,13 +673,13 @@ namespace rsa
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		bool operator<=(big_uint<block_t> const& a, uint_t b)
 		{
-			return (a <= big_uint<block_t>(b));
+			return (ops::cmp(a, b) <= 0);
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		bool operator<=(uint_t a, big_uint<block_t> const& b)
 		{
-			return (big_uint<block_t>(a) <= b);
+			return (0 <= ops::cmp(b, a));
 		}
 
 		template<class block_t>
@@ -601,13 +691,161 @@ namespace rsa
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		bool operator>=(big_uint<block_t> const& a, uint_t b)
 		{
-			return (a >= big_uint<block_t>(b));
+			return (ops::cmp(a, b) >= 0);
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		bool operator>=(uint_t a, big_uint<block_t> const& b)
 		{
-			return (big_uint<block_t>(a) >= b);
+			return (0 >= ops::cmp(b, a));
+		}
+
+#pragma endregion
+
+#pragma region comparison operators - views
+
+		template<class block_t>
+		bool operator==(big_uint_view<block_t> a, utils::identity_t<big_uint_view<block_t>> b)
+		{
+			return (ops::cmp(a, b) == 0);
+		}
+
+		template<class block_t>
+		bool operator==(big_uint<block_t> const& a, big_uint_view<block_t> b)
+		{
+			return (ops::cmp(big_uint_view<block_t>(a), b) == 0);
+		}
+
+		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+		bool operator==(big_uint_view<block_t> a, uint_t b)
+		{
+			return (ops::cmp(a, b) == 0);
+		}
+
+		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+		bool operator==(uint_t a, big_uint_view<block_t> b)
+		{
+			return (0 == ops::cmp(b, a));
+		}
+
+		template<class block_t>
+		bool operator!=(big_uint_view<block_t> a, utils::identity_t<big_uint_view<block_t>> b)
+		{
+			return (ops::cmp(a, b) != 0);
+		}
+
+		template<class block_t>
+		bool operator!=(big_uint<block_t> const& a, big_uint_view<block_t> b)
+		{
+			return (ops::cmp(big_uint_view<block_t>(a), b) != 0);
+		}
+
+		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+		bool operator!=(big_uint_view<block_t> a, uint_t b)
+		{
+			return (ops::cmp(a, b) != 0);
+		}
+
+		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+		bool operator!=(uint_t a, big_uint_view<block_t> b)
+		{
+			return (0 != ops::cmp(b, a));
+		}
+
+		template<class block_t>
+		bool operator<(big_uint_view<block_t> a, utils::identity_t<big_uint_view<block_t>> b)
+		{
+			return (ops::cmp(a, b) < 0);
+		}
+
+		template<class block_t>
+		bool operator<(big_uint<block_t> const& a, big_uint_view<block_t> b)
+		{
+			return (ops::cmp(big_uint_view<block_t>(a), b) < 0);
+		}
+
+		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+		bool operator<(big_uint_view<block_t> a, uint_t b)
+		{
+			return (ops::cmp(a, b) < 0);
+		}
+
+		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+		bool operator<(uint_t a, big_uint_view<block_t> b)
+		{
+			return (0 < ops::cmp(b, a));
+		}
+
+		template<class block_t>
+		bool operator>(big_uint_view<block_t> a, utils::identity_t<big_uint_view<block_t>> b)
+		{
+			return (ops::cmp(a, b) > 0);
+		}
+
+		template<class block_t>
+		bool operator>(big_uint<block_t> const& a, big_uint_view<block_t> b)
+		{
+			return (ops::cmp(big_uint_view<block_t>(a), b) > 0);
+		}
+
+		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+		bool operator>(big_uint_view<block_t> a, uint_t b)
+		{
+			return (ops::cmp(a, b) > 0);
+		}
+
+		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+		bool operator>(uint_t a, big_uint_view<block_t> b)
+		{
+			return (0 > ops::cmp(b, a));
+		}
+
+		template<class block_t>
+		bool operator<=(big_uint_view<block_t> a, utils::identity_t<big_uint_view<block_t>> b)
+		{
+			return (ops::cmp(a, b) <= 0);
+		}
+
+		template<class block_t>
+		bool operator<=(big_uint<block_t> const& a, big_uint_view<block_t> b)
+		{
+			return (ops::cmp(big_uint_view<block_t>(a), b) <= 0);
+		}
+
+		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+		bool operator<=(big_uint_view<block_t> a, uint_t b)
+		{
+			return (ops::cmp(a, b) <= 0);
+		}
+
+		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+		bool operator<=(uint_t a, big_uint_view<block_t> b)
+		{
+			return (0 <= ops::cmp(b, a));
+		}
+
+		template<class block_t>
+		bool operator>=(big_uint_view<block_t> a, utils::identity_t<big_uint_view<block_t>> b)
+		{
+			return (ops::cmp(a, b) >= 0);
+		}
+
+		template<class block_t>
+		bool operator>=(big_uint<block_t> const& a, big_uint_view<block_t> b)
+		{
+			return (ops::cmp(big_uint_view<block_t>(a), b) >= 0);
+		}
+
+		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+		bool operator>=(big_uint_view<block_t> a, uint_t b)
+		{
+			return (ops::cmp(a, b) >= 0);
+		}
+
+		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+		bool operator>=(uint_t a, big_uint_view<block_t> b)
+		{
+			return (0 >= ops::cmp(b, a));
 		}
 
 #pragma endregion
@@ -615,145 +853,325 @@ namespace rsa
 #pragma region bitwise operators
 
 		template<class block_t>
-		big_uint<block_t> operator&(big_uint<block_t> a, big_uint<block_t> const& b)
+		big_uint<block_t> operator&(big_uint<block_t> a, utils::identity_t<big_uint_view<block_t>> b)
 		{
-			return (a &= b);
+			a &= b;
+			return a;
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		big_uint<block_t> operator&(big_uint<block_t> a, uint_t b)
 		{
-			return (a &= big_uint<block_t>(b));
+			a &= b;
+			return a;
 		}
 
 		template<class block_t>
-		big_uint<block_t> operator|(big_uint<block_t> a, big_uint<block_t> const& b)
+		big_uint<block_t> operator|(big_uint<block_t> a, utils::identity_t<big_uint_view<block_t>> b)
 		{
-			return (a |= b);
+			a |= b;
+			return a;
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		big_uint<block_t> operator|(big_uint<block_t> a, uint_t b)
 		{
-			return (a |= big_uint<block_t>(b));
+			a |= b;
+			return a;
 		}
 
 		template<class block_t>
-		big_uint<block_t> operator^(big_uint<block_t> a, big_uint<block_t> const& b)
+		big_uint<block_t> operator^(big_uint<block_t> a, utils::identity_t<big_uint_view<block_t>> b)
 		{
-			return (a ^= b);
+			a ^= b;
+			return a;
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		big_uint<block_t> operator^(big_uint<block_t> a, uint_t b)
 		{
-			return (a ^= big_uint<block_t>(b));
+			a ^= b;
+			return a;
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		big_uint<block_t> operator<<(big_uint<block_t> a, uint_t b)
 		{
-			return (a <<= b);
+			a <<= b;
+			return a;
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		big_uint<block_t> operator>>(big_uint<block_t> a, uint_t b)
 		{
-			return (a >>= b);
+			a >>= b;
+			return a;
 		}
 
 #pragma endregion
 
 #pragma region math operators
 
+		// note: the operators taking an rvalue big_uint write the result over it (or the other rvalue operand, if only that one has
+		// enough capacity for the result), so chained expressions like (a * b) % n don't allocate for each temporary. the result
+		// keeps that operand's allocator. otherwise a new result is made with the left operand's allocator, sized for the result.
+		// scratch space comes from default_workspace(), except in multiplications big enough for the ntt (see ops::thresholds()),
+		// whose transform buffers are allocated from the default resource.
+
+		template<class block_t>
+		big_uint<block_t> operator+(big_uint<block_t> const& a, utils::identity_t<big_uint_view<block_t>> b)
+		{
+			auto result = big_uint<block_t>(a.get_allocator());
+			result.data().reserve(std::max(a.data().size(), b.data().size()) + 1u);
+			ops::add(result, a, b);
+			return result;
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator+(big_uint<block_t>&& a, utils::identity_t<big_uint_view<block_t>> b)
+		{
+			a += b;
+			return std::move(a);
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator+(utils::identity_t<big_uint_view<block_t>> a, big_uint<block_t>&& b)
+		{
+			b += a;
+			return std::move(b);
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator+(big_uint<block_t> const& a, big_uint<block_t>&& b)
+		{
+			b += a;
+			return std::move(b);
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator+(big_uint<block_t>&& a, big_uint<block_t>&& b)
+		{
+			auto const size = std::max(a.data().size(), b.data().size()) + 1u;
+
+			if (!ops::has_capacity(a, size) && ops::has_capacity(b, size))
+				return (std::move(b) + a);
+
+			return (std::move(a) + b);
+		}
+
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		big_uint<block_t> operator+(big_uint<block_t> a, uint_t b)
 		{
-			return (a += big_uint<block_t>(b));
+			a += b;
+			return a;
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
-		big_uint<block_t> operator+(uint_t a, big_uint<block_t> const& b)
+		big_uint<block_t> operator+(uint_t a, big_uint<block_t> b)
 		{
-			return (big_uint<block_t>(a) += b);
+			b += a;
+			return b;
 		}
 
 		template<class block_t>
-		big_uint<block_t> operator+(big_uint<block_t> a, big_uint<block_t> const& b)
+		big_uint<block_t> operator-(big_uint<block_t> const& a, utils::identity_t<big_uint_view<block_t>> b)
 		{
-			return (a += b);
+			auto result = big_uint<block_t>(a.get_allocator());
+			ops::sub(result, a, b);
+			return result;
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator-(big_uint<block_t>&& a, utils::identity_t<big_uint_view<block_t>> b)
+		{
+			a -= b;
+			return std::move(a);
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator-(utils::identity_t<big_uint_view<block_t>> a, big_uint<block_t>&& b)
+		{
+			ops::sub(b, a, b);
+			return std::move(b);
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator-(big_uint<block_t> const& a, big_uint<block_t>&& b)
+		{
+			ops::sub(b, a, b);
+			return std::move(b);
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator-(big_uint<block_t>&& a, big_uint<block_t>&& b)
+		{
+			a -= b;
+			return std::move(a);
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		big_uint<block_t> operator-(big_uint<block_t> a, uint_t b)
 		{
-			return (a -= big_uint<block_t>(b));
+			a -= b;
+			return a;
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		big_uint<block_t> operator-(uint_t a, big_uint<block_t> const& b)
 		{
-			return (big_uint<block_t>(a) -= b);
+			auto result = big_uint<block_t>(a, b.get_allocator());
+			result -= b;
+			return result;
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator*(big_uint<block_t> const& a, utils::identity_t<big_uint_view<block_t>> b)
+		{
+			auto result = big_uint<block_t>(a.get_allocator());
+			result.data().reserve(a.data().size() + b.data().size());
+			ops::mul(result, a, b);
+			return result;
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator*(big_uint<block_t>&& a, utils::identity_t<big_uint_view<block_t>> b)
+		{
+			a *= b;
+			return std::move(a);
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator*(utils::identity_t<big_uint_view<block_t>> a, big_uint<block_t>&& b)
+		{
+			b *= a;
+			return std::move(b);
 		}
 
 		template<class block_t>
-		big_uint<block_t> operator-(big_uint<block_t> a, big_uint<block_t> const& b)
+		big_uint<block_t> operator*(big_uint<block_t> const& a, big_uint<block_t>&& b)
 		{
-			return (a -= b);
+			b *= a;
+			return std::move(b);
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator*(big_uint<block_t>&& a, big_uint<block_t>&& b)
+		{
+			auto const size = a.data().size() + b.data().size();
+
+			if (!ops::has_capacity(a, size) && ops::has_capacity(b, size))
+				return (std::move(b) * a);
+
+			return (std::move(a) * b);
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		big_uint<block_t> operator*(big_uint<block_t> a, uint_t b)
 		{
-			return (a *= big_uint<block_t>(b));
+			a *= b;
+			return a;
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
-		big_uint<block_t> operator*(uint_t a, big_uint<block_t> const& b)
+		big_uint<block_t> operator*(uint_t a, big_uint<block_t> b)
+		{
+			b *= a;
+			return b;
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator/(big_uint<block_t> const& a, utils::identity_t<big_uint_view<block_t>> b)
 		{
-			return (big_uint<block_t>(a) *= b);
+			auto result = a;
+			result /= b;
+			return result;
 		}
 
 		template<class block_t>
-		big_uint<block_t> operator*(big_uint<block_t> a, big_uint<block_t> const& b)
+		big_uint<block_t> operator/(big_uint<block_t>&& a, utils::identity_t<big_uint_view<block_t>> b)
 		{
-			return (a *= b);
+			a /= b;
+			return std::move(a);
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		big_uint<block_t> operator/(big_uint<block_t> a, uint_t b)
 		{
-			return (a /= big_uint<block_t>(b));
+			a /= b;
+			return a;
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		big_uint<block_t> operator/(uint_t a, big_uint<block_t> const& b)
 		{
-			return (big_uint<block_t>(a) /= b);
+			auto result = big_uint<block_t>(a, b.get_allocator());
+			result /= b;
+			return result;
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator%(big_uint<block_t> const& a, utils::identity_t<big_uint_view<block_t>> b)
+		{
+			// (the remainder is no larger than b, so there's no need to copy a)
+			auto result = big_uint<block_t>(a.get_allocator());
+			result.data().reserve(b.data().size());
+			ops::mod(result, a, b);
+			return result;
 		}
 
 		template<class block_t>
-		big_uint<block_t> operator/(big_uint<block_t> a, big_uint<block_t> const& b)
+		big_uint<block_t> operator%(big_uint<block_t>&& a, utils::identity_t<big_uint_view<block_t>> b)
 		{
-			return (a /= b);
+			a %= b;
+			return std::move(a);
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator%(utils::identity_t<big_uint_view<block_t>> a, big_uint<block_t>&& b)
+		{
+			ops::mod(b, a, b);
+			return std::move(b);
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator%(big_uint<block_t> const& a, big_uint<block_t>&& b)
+		{
+			ops::mod(b, a, b);
+			return std::move(b);
+		}
+
+		template<class block_t>
+		big_uint<block_t> operator%(big_uint<block_t>&& a, big_uint<block_t>&& b)
+		{
+			a %= b;
+			return std::move(a);
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
-		big_uint<block_t> operator%(big_uint<block_t> a, uint_t b)
+		big_uint<block_t> operator%(big_uint<block_t> const& a, uint_t b)
 		{
-			return (a %= big_uint<block_t>(b));
+			// (the remainder is less than b, so there's no need to copy a)
+			return big_uint<block_t>(ops::mod(a, b), a.get_allocator());
 		}
 
 		template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
 		big_uint<block_t> operator%(uint_t a, big_uint<block_t> const& b)
 		{
-			return (big_uint<block_t>(a) %= b);
+			auto result = big_uint<block_t>(a, b.get_allocator());
+			result %= b;
+			return result;
 		}
 
+#pragma endregion
+
+#pragma region math functions
+
+		// squares a in place (as a *= a). uses a dedicated squaring algorithm, which is faster than general multiplication.
 		template<class block_t>
-		big_uint<block_t> operator%(big_uint<block_t> a, big_uint<block_t> const& b)
+		big_uint<block_t>& square(big_uint<block_t>& a)
 		{
-			return (a %= b);
+			ops::sqr_assign(a);
+			return a;
 		}
 
 #pragma endregion
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "rsa__debug.h"
+#include "rsa_math__utils.h"
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+namespace rsa
+{
+
+	namespace math
+	{
+
+		template<class block_t>
+		class big_uint;
+
+		// a read-only range of blocks (a pointer and a size). provides the subset of the std::vector interface used to read big_uint data.
+		template<class block_t>
+		class block_span
+		{
+		public:
+
+			using value_type = block_t;
+			using size_type = std::size_t;
+			using const_reference = block_t const&;
+			using const_pointer = block_t const*;
+			using const_iterator = block_t const*;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+#pragma region constructors
+
+			block_span();
+			block_span(block_t const* data, size_type size);
+
+#pragma endregion
+
+#pragma region element access
+
+			const_reference operator[](size_type i) const;
+
+			const_reference front() const;
+			const_reference back() const;
+
+			const_pointer data() const;
+
+#pragma endregion
+
+#pragma region iterators
+
+			const_iterator begin() const;
+			const_iterator end() const;
+
+			const_reverse_iterator rbegin() const;
+			const_reverse_iterator rend() const;
+
+#pragma endregion
+
+#pragma region capacity
+
+			bool empty() const;
+			size_type size() const;
+
+#pragma endregion
+
+		private:
+
+			block_t const* m_data;
+			size_type m_size;
+		};
+
+		// a non-owning, read-only view of a number stored elsewhere (in a big_uint, or any other memory holding blocks, least significant first).
+		// high zero blocks are excluded on construction. the blocks must outlive the view, and not be changed while it's used.
+		// big_uint converts to big_uint_view implicitly, and the math operations accept views wherever they only read an operand.
+		// note: a view may refer to the same blocks as the result of an operation (as if the same big_uint was passed twice), but mustn't
+		// partially overlap them.
+		template<class block_t>
+		class big_uint_view
+		{
+		public:
+
+			using block_type = block_t;
+			using data_type = block_span<block_type>;
+			using bit_index_type = std::size_t;
+
+			static_assert(utils::is_uint_v<block_type>, "`block_type` must be an unsigned integer.");
+
+#pragma region constructors
+
+			big_uint_view();
+			big_uint_view(block_type const* blocks, std::size_t block_count);
+			big_uint_view(big_uint<block_type> const& n);
+
+#pragma endregion
+
+#pragma region general
+
+			bool is_zero() const;
+
+			bool get_bit(bit_index_type i) const;
+
+			bit_index_type get_most_significant_bit() const;
+
+			data_type data() const;
+
+#pragma endregion
+
+		private:
+
+			data_type m_data;
+		};
+
+#pragma region members - constructors
+
+		template<class block_t>
+		block_span<block_t>::block_span():
+			m_data(nullptr),
+			m_size(0u)
+		{
+
+		}
+
+		template<class block_t>
+		block_span<block_t>::block_span(block_t const* data, size_type size):
+			m_data(data),
+			m_size(size)
+		{
+			debug::die_if(data == nullptr && size != 0u);
+		}
+
+#pragma endregion
+
+#pragma region members - element access
+
+		template<class block_t>
+		typename block_span<block_t>::const_reference block_span<block_t>::operator[](size_type i) const
+		{
+			return m_data[i];
+		}
+
+		template<class block_t>
+		typename block_span<block_t>::const_reference block_span<block_t>::front() const
+		{
+			return m_data[0];
+		}
+
+		template<class block_t>
+		typename block_span<block_t>::const_reference block_span<block_t>::back() const
+		{
+			return m_data[m_size - 1u];
+		}
+
+		template<class block_t>
+		typename block_span<block_t>::const_pointer block_span<block_t>::data() const
+		{
+			return m_data;
+		}
+
+#pragma endregion
+
+#pragma region members - iterators
+
+		template<class block_t>
+		typename block_span<block_t>::const_iterator block_span<block_t>::begin() const
+		{
+			return m_data;
+		}
+
+		template<class block_t>
+		typename block_span<block_t>::const_iterator block_span<block_t>::end() const
+		{
+			return m_data + m_size;
+		}
+
+		template<class block_t>
+		typename block_span<block_t>::const_reverse_iterator block_span<block_t>::rbegin() const
+		{
+			return const_reverse_iterator(end());
+		}
+
+		template<class block_t>
+		typename block_span<block_t>::const_reverse_iterator block_span<block_t>::rend() const
+		{
+			return const_reverse_iterator(begin());
+		}
+
+#pragma endregion
+
+#pragma region members - capacity
+
+		template<class block_t>
+		bool block_span<block_t>::empty() const
+		{
+			return (m_size == 0u);
+		}
+
+		template<class block_t>
+		typename block_span<block_t>::size_type block_span<block_t>::size() const
+		{
+			return m_size;
+		}
+
+#pragma endregion
+
+#pragma region members - constructors
+
+		template<class block_t>
+		big_uint_view<block_t>::big_uint_view()
+		{
+
+		}
+
+		template<class block_t>
+		big_uint_view<block_t>::big_uint_view(block_type const* blocks, std::size_t block_count)
+		{
+			while (block_count != 0u && blocks[block_count - 1u] == block_type{ 0 })
+				--block_count;
+
+			m_data = data_type(blocks, block_count);
+		}
+
+		template<class block_t>
+		big_uint_view<block_t>::big_uint_view(big_uint<block_type> const& n):
+			m_data(n.data().data(), n.data().size())
+		{
+
+		}
+
+#pragma endregion
+
+#pragma region members - general
+
+		template<class block_t>
+		bool big_uint_view<block_t>::is_zero() const
+		{
+			return m_data.empty();
+		}
+
+		template<class block_t>
+		bool big_uint_view<block_t>::get_bit(bit_index_type i) const
+		{
+			auto const block_index = i / utils::digits<block_type>();
+
+			if (m_data.size() <= block_index)
+				return false;
+
+			return bool((m_data[block_index] >> (i % utils::digits<block_type>())) & 1u);
+		}
+
+		template<class block_t>
+		typename big_uint_view<block_t>::bit_index_type big_uint_view<block_t>::get_most_significant_bit() const
+		{
+			if (is_zero())
+				throw std::logic_error("number must not be zero.");
+
+			auto block = m_data.back();
+			auto count = bit_index_type{ 0 };
+
+			while (block != block_type{ 1u })
+			{
+				++count;
+				block >>= 1u;
+			}
+
+			return count + (m_data.size() - 1u) * utils::digits<block_type>();
+		}
+
+		template<class block_t>
+		typename big_uint_view<block_t>::data_type big_uint_view<block_t>::data() const
+		{
+			return m_data;
+		}
+
+#pragma endregion
+
+	} // math
+
+} // rsa
@@ -0,0 +1,615 @@
+#pragma once
+
+#include "rsa__debug.h"
+#include "rsa_math__big_uint.h"
+#include "rsa_math__big_uint_view.h"
+#include "rsa_math__utils.h"
+#include "rsa_math__workspace.h"
+#include "rsa_math_ops__blocks.h"
+#include "rsa_math_ops__division.h"
+#include "rsa_math_ops__multiplication.h"
+#include "rsa_math_ops__operations.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace rsa
+{
+
+	namespace math
+	{
+
+		// opt-in expression templates. arithmetic on expr::lazy(a) builds an expression instead of calculating each step. the
+		// expression is calculated when it's compared, converted to a big_uint, or passed to expr::assign, with the intermediate
+		// values kept in a workspace (so no temporary big_uints are made). some shapes are fused:
+		//   (lazy(a) * b) % n     multiply-then-reduce: the product is reduced where it's calculated.
+		//   lazy(a) * b + c       multiply-accumulate: c is added to the product in place.
+		//   lazy(x) * lazy(x)     squaring: the same operand on both sides (including the same sub-expression) is squared.
+		//   lazy(a) * b <= n      compare: the product is only calculated if the operand sizes don't decide the comparison.
+		// note: expressions refer to their operands (holding views of them), so should be used in the statement that makes them,
+		// not stored (e.g. with auto).
+		namespace expr
+		{
+
+			// base class of the expressions. derived_t provides:
+			//   block_type,
+			//   big_uint_view<block_type> evaluate(frame&, workspace&) const, calculating the value (with blocks allocated from the frame),
+			//   bool same_as(derived_t const&) const, whether the other expression is known to have the same value.
+			template<class derived_t>
+			class expression
+			{
+			public:
+
+#pragma region conversion
+
+				template<class block_t>
+				operator big_uint<block_t>() const;
+
+#pragma endregion
+
+#pragma region general
+
+				// compares the value with target. returns -1, 0 or 1.
+				template<class block_t>
+				int compare(big_uint_view<block_t> target, typename workspace<block_t>::frame& frame, workspace<block_t>& ws) const;
+
+#pragma endregion
+
+			protected:
+
+				derived_t const& derived() const;
+			};
+
+			template<class t>
+			constexpr bool is_expression_v = std::is_base_of_v<expression<t>, t>;
+
+			// a number (a view of a big_uint, or other blocks).
+			template<class block_t>
+			class value : public expression<value<block_t>>
+			{
+			public:
+
+				using block_type = block_t;
+
+				explicit value(big_uint_view<block_type> n);
+
+				big_uint_view<block_type> evaluate(typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const;
+				bool same_as(value const& other) const;
+
+			private:
+
+				big_uint_view<block_type> m_value;
+			};
+
+			// an unsigned integer operand.
+			template<class block_t, class uint_t>
+			class constant : public expression<constant<block_t, uint_t>>
+			{
+			public:
+
+				using block_type = block_t;
+
+				static_assert(utils::is_uint_v<uint_t>, "`uint_t` must be an unsigned integer.");
+
+				explicit constant(uint_t n);
+
+				big_uint_view<block_type> evaluate(typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const;
+				bool same_as(constant const& other) const;
+
+			private:
+
+				uint_t m_value;
+			};
+
+			// the binary expressions (holding their operand expressions by value).
+			template<class lhs_t, class rhs_t>
+			class binary
+			{
+			public:
+
+				using block_type = typename lhs_t::block_type;
+
+				static_assert(std::is_same_v<block_type, typename rhs_t::block_type>, "operands must have the same block type.");
+
+				binary(lhs_t lhs, rhs_t rhs);
+
+				lhs_t const& lhs() const;
+				rhs_t const& rhs() const;
+
+				bool same_as(binary const& other) const;
+
+			private:
+
+				lhs_t m_lhs;
+				rhs_t m_rhs;
+			};
+
+			template<class lhs_t, class rhs_t>
+			class product : public expression<product<lhs_t, rhs_t>>, public binary<lhs_t, rhs_t>
+			{
+			public:
+
+				using typename binary<lhs_t, rhs_t>::block_type;
+				using binary<lhs_t, rhs_t>::binary;
+
+				big_uint_view<block_type> evaluate(typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const;
+
+				// (lhs * rhs) + c, adding c to the product in place.
+				big_uint_view<block_type> evaluate_plus(big_uint_view<block_type> c, typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const;
+
+				int compare(big_uint_view<block_type> target, typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const;
+
+			private:
+
+				// evaluates the operands (once, if they're the same).
+				std::pair<big_uint_view<block_type>, big_uint_view<block_type>> evaluate_operands(typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const;
+
+				// a * b, in size (at least an + bn) blocks allocated from the frame.
+				static block_type* multiply(big_uint_view<block_type> a, big_uint_view<block_type> b, std::size_t size, typename workspace<block_type>::frame& frame, workspace<block_type>& ws);
+			};
+
+			template<class t>
+			struct is_product : std::false_type { };
+
+			template<class lhs_t, class rhs_t>
+			struct is_product<product<lhs_t, rhs_t>> : std::true_type { };
+
+			template<class lhs_t, class rhs_t>
+			class sum : public expression<sum<lhs_t, rhs_t>>, public binary<lhs_t, rhs_t>
+			{
+			public:
+
+				using typename binary<lhs_t, rhs_t>::block_type;
+				using binary<lhs_t, rhs_t>::binary;
+
+				big_uint_view<block_type> evaluate(typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const;
+			};
+
+			template<class lhs_t, class rhs_t>
+			class difference : public expression<difference<lhs_t, rhs_t>>, public binary<lhs_t, rhs_t>
+			{
+			public:
+
+				using typename binary<lhs_t, rhs_t>::block_type;
+				using binary<lhs_t, rhs_t>::binary;
+
+				big_uint_view<block_type> evaluate(typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const;
+			};
+
+			template<class lhs_t, class rhs_t>
+			class remainder : public expression<remainder<lhs_t, rhs_t>>, public binary<lhs_t, rhs_t>
+			{
+			public:
+
+				using typename binary<lhs_t, rhs_t>::block_type;
+				using binary<lhs_t, rhs_t>::binary;
+
+				big_uint_view<block_type> evaluate(typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const;
+			};
+
+#pragma region operands
+
+			template<class t>
+			struct is_number : std::false_type { };
+
+			template<class block_t>
+			struct is_number<big_uint<block_t>> : std::true_type { };
+
+			template<class block_t>
+			struct is_number<big_uint_view<block_t>> : std::true_type { };
+
+			template<class t>
+			constexpr bool is_operand_v = (is_expression_v<t> || is_number<t>::value || utils::is_uint_v<t>);
+
+			// enables the operators below when at least one side is an expression.
+			template<class lhs_t, class rhs_t>
+			using enable_if_expression_t = std::enable_if_t<(is_expression_v<lhs_t> || is_expression_v<rhs_t>) && is_operand_v<lhs_t> && is_operand_v<rhs_t>>;
+
+			// x as an expression. (the block type of an unsigned integer comes from the other operand.)
+			template<class other_t, class t>
+			auto as_operand(t const& x)
+			{
+				if constexpr (is_expression_v<t>)
+					return x;
+				else if constexpr (utils::is_uint_v<t>)
+					return constant<typename other_t::block_type, t>(x);
+				else
+					return value<typename t::block_type>(x);
+			}
+
+			template<class t, class other_t>
+			using operand_t = decltype(as_operand<other_t>(std::declval<t const&>()));
+
+			template<class block_t>
+			value<block_t> lazy(big_uint<block_t> const& n)
+			{
+				return value<block_t>(n);
+			}
+
+			// (the expression would refer to the temporary after it's destroyed)
+			template<class block_t>
+			value<block_t> lazy(big_uint<block_t>&& n) = delete;
+
+			template<class block_t>
+			value<block_t> lazy(big_uint_view<block_t> n)
+			{
+				return value<block_t>(n);
+			}
+
+#pragma endregion
+
+#pragma region evaluation
+
+			// out = e. out may be one of the operands of e. temporary storage is taken from ws.
+			template<class block_t, class derived_t>
+			void assign(big_uint<block_t>& out, expression<derived_t> const& e, workspace<block_t>& ws = default_workspace<block_t>())
+			{
+				auto frame = typename workspace<block_t>::frame(ws);
+				auto const result = static_cast<derived_t const&>(e).evaluate(frame, ws);
+
+				// (the result is out itself if e is just out)
+				if (ops::aliases(out, result))
+					return;
+
+				out.data().assign(result.data().begin(), result.data().end());
+			}
+
+			// compares lhs with rhs (at least one of which is an expression). returns -1, 0 or 1.
+			template<class lhs_t, class rhs_t, typename = enable_if_expression_t<lhs_t, rhs_t>>
+			int compare(lhs_t const& lhs, rhs_t const& rhs)
+			{
+				auto const a = as_operand<rhs_t>(lhs);
+				auto const b = as_operand<lhs_t>(rhs);
+
+				using block_t = typename decltype(a)::block_type;
+
+				auto& ws = default_workspace<block_t>();
+				auto frame = typename workspace<block_t>::frame(ws);
+
+				return a.compare(b.evaluate(frame, ws), frame, ws);
+			}
+
+#pragma endregion
+
+#pragma region members - expression
+
+			template<class derived_t>
+			template<class block_t>
+			expression<derived_t>::operator big_uint<block_t>() const
+			{
+				static_assert(std::is_same_v<block_t, typename derived_t::block_type>, "expressions only convert to a big_uint with the same block type.");
+
+				auto result = big_uint<block_t>();
+				assign(result, *this);
+
+				return result;
+			}
+
+			template<class derived_t>
+			template<class block_t>
+			int expression<derived_t>::compare(big_uint_view<block_t> target, typename workspace<block_t>::frame& frame, workspace<block_t>& ws) const
+			{
+				return ops::cmp(derived().evaluate(frame, ws), target);
+			}
+
+			template<class derived_t>
+			derived_t const& expression<derived_t>::derived() const
+			{
+				return static_cast<derived_t const&>(*this);
+			}
+
+#pragma endregion
+
+#pragma region members - value
+
+			template<class block_t>
+			value<block_t>::value(big_uint_view<block_type> n):
+				m_value(n)
+			{
+
+			}
+
+			template<class block_t>
+			big_uint_view<block_t> value<block_t>::evaluate(typename workspace<block_type>::frame&, workspace<block_type>&) const
+			{
+				return m_value;
+			}
+
+			template<class block_t>
+			bool value<block_t>::same_as(value const& other) const
+			{
+				return (m_value.data().data() == other.m_value.data().data() && m_value.data().size() == other.m_value.data().size());
+			}
+
+#pragma endregion
+
+#pragma region members - constant
+
+			template<class block_t, class uint_t>
+			constant<block_t, uint_t>::constant(uint_t n):
+				m_value(n)
+			{
+
+			}
+
+			template<class block_t, class uint_t>
+			big_uint_view<block_t> constant<block_t, uint_t>::evaluate(typename workspace<block_type>::frame& frame, workspace<block_type>&) const
+			{
+				auto const b = utils::to_blocks<block_t>(m_value);
+
+				auto const r = frame.allocate(b.size);
+				std::copy(b.blocks.begin(), b.blocks.begin() + b.size, r);
+
+				return big_uint_view<block_t>(r, b.size);
+			}
+
+			template<class block_t, class uint_t>
+			bool constant<block_t, uint_t>::same_as(constant const& other) const
+			{
+				return (m_value == other.m_value);
+			}
+
+#pragma endregion
+
+#pragma region members - binary
+
+			template<class lhs_t, class rhs_t>
+			binary<lhs_t, rhs_t>::binary(lhs_t lhs, rhs_t rhs):
+				m_lhs(std::move(lhs)),
+				m_rhs(std::move(rhs))
+			{
+
+			}
+
+			template<class lhs_t, class rhs_t>
+			lhs_t const& binary<lhs_t, rhs_t>::lhs() const
+			{
+				return m_lhs;
+			}
+
+			template<class lhs_t, class rhs_t>
+			rhs_t const& binary<lhs_t, rhs_t>::rhs() const
+			{
+				return m_rhs;
+			}
+
+			template<class lhs_t, class rhs_t>
+			bool binary<lhs_t, rhs_t>::same_as(binary const& other) const
+			{
+				return (m_lhs.same_as(other.m_lhs) && m_rhs.same_as(other.m_rhs));
+			}
+
+#pragma endregion
+
+#pragma region members - product
+
+			template<class lhs_t, class rhs_t>
+			std::pair<big_uint_view<typename product<lhs_t, rhs_t>::block_type>, big_uint_view<typename product<lhs_t, rhs_t>::block_type>>
+				product<lhs_t, rhs_t>::evaluate_operands(typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const
+			{
+				auto const a = this->lhs().evaluate(frame, ws);
+
+				if constexpr (std::is_same_v<lhs_t, rhs_t>)
+					if (this->lhs().same_as(this->rhs()))
+						return { a, a };
+
+				return { a, this->rhs().evaluate(frame, ws) };
+			}
+
+			template<class lhs_t, class rhs_t>
+			typename product<lhs_t, rhs_t>::block_type* product<lhs_t, rhs_t>::multiply(big_uint_view<block_type> a, big_uint_view<block_type> b, std::size_t size, typename workspace<block_type>::frame& frame, workspace<block_type>& ws)
+			{
+				auto const an = a.data().size();
+				auto const bn = b.data().size();
+
+				debug::die_if(size < an + bn);
+
+				auto const r = frame.allocate(size);
+
+				if (an == 0u || bn == 0u)
+					return r;
+
+				if (a.data().data() == b.data().data() && an == bn)
+					ops::blocks::sqr_n(r, a.data().data(), an, ws);
+				else
+					ops::blocks::mul(r, a.data().data(), an, b.data().data(), bn, ws);
+
+				return r;
+			}
+
+			template<class lhs_t, class rhs_t>
+			big_uint_view<typename product<lhs_t, rhs_t>::block_type> product<lhs_t, rhs_t>::evaluate(typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const
+			{
+				auto const [a, b] = evaluate_operands(frame, ws);
+				auto const size = a.data().size() + b.data().size();
+
+				return big_uint_view<block_type>(multiply(a, b, size, frame, ws), size);
+			}
+
+			template<class lhs_t, class rhs_t>
+			big_uint_view<typename product<lhs_t, rhs_t>::block_type> product<lhs_t, rhs_t>::evaluate_plus(big_uint_view<block_type> c, typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const
+			{
+				auto const [a, b] = evaluate_operands(frame, ws);
+
+				// (with a high block for the carry)
+				auto const size = std::max(a.data().size() + b.data().size(), c.data().size()) + 1u;
+				auto const r = multiply(a, b, size, frame, ws);
+
+				r[size - 1u] = ops::blocks::add(r, r, size - 1u, c.data().data(), c.data().size());
+
+				return big_uint_view<block_type>(r, size);
+			}
+
+			template<class lhs_t, class rhs_t>
+			int product<lhs_t, rhs_t>::compare(big_uint_view<block_type> target, typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const
+			{
+				auto const [a, b] = evaluate_operands(frame, ws);
+
+				if (a.is_zero() || b.is_zero())
+					return target.is_zero() ? 0 : -1;
+
+				// the product has an + bn - 1 or an + bn blocks
+				auto const size = a.data().size() + b.data().size();
+				auto const target_size = target.data().size();
+
+				if (size - 1u > target_size)
+					return 1;
+
+				if (size < target_size)
+					return -1;
+
+				return ops::cmp(big_uint_view<block_type>(multiply(a, b, size, frame, ws), size), target);
+			}
+
+#pragma endregion
+
+#pragma region members - sum
+
+			template<class lhs_t, class rhs_t>
+			big_uint_view<typename sum<lhs_t, rhs_t>::block_type> sum<lhs_t, rhs_t>::evaluate(typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const
+			{
+				// multiply-accumulate
+				if constexpr (is_product<lhs_t>::value)
+					return this->lhs().evaluate_plus(this->rhs().evaluate(frame, ws), frame, ws);
+				else if constexpr (is_product<rhs_t>::value)
+					return this->rhs().evaluate_plus(this->lhs().evaluate(frame, ws), frame, ws);
+				else
+				{
+					auto const a = this->lhs().evaluate(frame, ws);
+					auto const b = this->rhs().evaluate(frame, ws);
+
+					auto const& l = (a.data().size() < b.data().size()) ? b : a;
+					auto const& s = (a.data().size() < b.data().size()) ? a : b;
+					auto const size = l.data().size() + 1u;
+
+					auto const r = frame.allocate(size);
+					r[size - 1u] = ops::blocks::add(r, l.data().data(), l.data().size(), s.data().data(), s.data().size());
+
+					return big_uint_view<block_type>(r, size);
+				}
+			}
+
+#pragma endregion
+
+#pragma region members - difference
+
+			template<class lhs_t, class rhs_t>
+			big_uint_view<typename difference<lhs_t, rhs_t>::block_type> difference<lhs_t, rhs_t>::evaluate(typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const
+			{
+				auto const a = this->lhs().evaluate(frame, ws);
+				auto const b = this->rhs().evaluate(frame, ws);
+
+				if (ops::cmp(a, b) < 0)
+					throw std::invalid_argument("cannot subtract larger value from smaller one.");
+
+				auto const size = a.data().size();
+
+				auto const r = frame.allocate(size);
+				ops::blocks::sub(r, a.data().data(), size, b.data().data(), b.data().size());
+
+				return big_uint_view<block_type>(r, size);
+			}
+
+#pragma endregion
+
+#pragma region members - remainder
+
+			template<class lhs_t, class rhs_t>
+			big_uint_view<typename remainder<lhs_t, rhs_t>::block_type> remainder<lhs_t, rhs_t>::evaluate(typename workspace<block_type>::frame& frame, workspace<block_type>& ws) const
+			{
+				auto const a = this->lhs().evaluate(frame, ws);
+				auto const d = this->rhs().evaluate(frame, ws);
+
+				if (d.is_zero())
+					throw std::invalid_argument("divisor cannot be zero.");
+
+				if (ops::cmp(a, d) < 0)
+					return a;
+
+				// multiply-then-reduce (if a is a product, it's only stored in the workspace)
+				auto const size = d.data().size();
+
+				auto const r = frame.allocate(size);
+				ops::blocks::tdiv_qr<block_type>(nullptr, r, a.data().data(), a.data().size(), d.data().data(), size, ws);
+
+				return big_uint_view<block_type>(r, size);
+			}
+
+#pragma endregion
+
+#pragma region math operators
+
+			template<class lhs_t, class rhs_t, typename = enable_if_expression_t<lhs_t, rhs_t>>
+			auto operator+(lhs_t const& lhs, rhs_t const& rhs)
+			{
+				return sum<operand_t<lhs_t, rhs_t>, operand_t<rhs_t, lhs_t>>(as_operand<rhs_t>(lhs), as_operand<lhs_t>(rhs));
+			}
+
+			template<class lhs_t, class rhs_t, typename = enable_if_expression_t<lhs_t, rhs_t>>
+			auto operator-(lhs_t const& lhs, rhs_t const& rhs)
+			{
+				return difference<operand_t<lhs_t, rhs_t>, operand_t<rhs_t, lhs_t>>(as_operand<rhs_t>(lhs), as_operand<lhs_t>(rhs));
+			}
+
+			template<class lhs_t, class rhs_t, typename = enable_if_expression_t<lhs_t, rhs_t>>
+			auto operator*(lhs_t const& lhs, rhs_t const& rhs)
+			{
+				return product<operand_t<lhs_t, rhs_t>, operand_t<rhs_t, lhs_t>>(as_operand<rhs_t>(lhs), as_operand<lhs_t>(rhs));
+			}
+
+			template<class lhs_t, class rhs_t, typename = enable_if_expression_t<lhs_t, rhs_t>>
+			auto operator%(lhs_t const& lhs, rhs_t const& rhs)
+			{
+				return remainder<operand_t<lhs_t, rhs_t>, operand_t<rhs_t, lhs_t>>(as_operand<rhs_t>(lhs), as_operand<lhs_t>(rhs));
+			}
+
+#pragma endregion
+
+#pragma region comparison operators
+
+			template<class lhs_t, class rhs_t, typename = enable_if_expression_t<lhs_t, rhs_t>>
+			bool operator==(lhs_t const& lhs, rhs_t const& rhs)
+			{
+				return (compare(lhs, rhs) == 0);
+			}
+
+			template<class lhs_t, class rhs_t, typename = enable_if_expression_t<lhs_t, rhs_t>>
+			bool operator!=(lhs_t const& lhs, rhs_t const& rhs)
+			{
+				return (compare(lhs, rhs) != 0);
+			}
+
+			template<class lhs_t, class rhs_t, typename = enable_if_expression_t<lhs_t, rhs_t>>
+			bool operator<(lhs_t const& lhs, rhs_t const& rhs)
+			{
+				return (compare(lhs, rhs) < 0);
+			}
+
+			template<class lhs_t, class rhs_t, typename = enable_if_expression_t<lhs_t, rhs_t>>
+			bool operator>(lhs_t const& lhs, rhs_t const& rhs)
+			{
+				return (compare(lhs, rhs) > 0);
+			}
+
+			template<class lhs_t, class rhs_t, typename = enable_if_expression_t<lhs_t, rhs_t>>
+			bool operator<=(lhs_t const& lhs, rhs_t const& rhs)
+			{
+				return (compare(lhs, rhs) <= 0);
+			}
+
+			template<class lhs_t, class rhs_t, typename = enable_if_expression_t<lhs_t, rhs_t>>
+			bool operator>=(lhs_t const& lhs, rhs_t const& rhs)
+			{
+				return (compare(lhs, rhs) >= 0);
+			}
+
+#pragma endregion
+
+		} // expr
+
+	} // math
+
+} // rsa
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "rsa__debug.h"
+#include "rsa_math__big_uint.h"
+#include "rsa_math__fixed_uint.h"
+#include "rsa_math__montgomery.h"
+#include "rsa_math__utils.h"
+#include "rsa_math_ops__blocks.h"
+#include "rsa_math_ops__multiplication.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+namespace rsa
+{
+
+	namespace math
+	{
+
+		// montgomery multiplication (as montgomery_context) for fixed_uint values, with R = 2^bits.
+		// only the constructor allocates. the arithmetic uses fixed size buffers on the stack.
+		template<std::size_t bits, class block_t = std::uint32_t>
+		class fixed_montgomery_context
+		{
+		public:
+
+			using block_type = block_t;
+			using value_type = fixed_uint<bits, block_t>;
+			using double_value_type = fixed_uint<2u * bits, block_t>;
+
+#pragma region constructors
+
+			explicit fixed_montgomery_context(value_type const& modulus);
+
+#pragma endregion
+
+#pragma region general
+
+			value_type const& modulus() const;
+
+			// a * R mod n. a may be larger than n.
+			value_type to_montgomery(value_type const& a) const;
+
+			// a * R^-1 mod n. a must be less than n.
+			value_type from_montgomery(value_type const& a) const;
+
+			// 1 in montgomery form (R mod n).
+			value_type const& one() const;
+
+#pragma endregion
+
+#pragma region math
+
+			// t * R^-1 mod n. t must be less than n * R (e.g. the product of two values less than n).
+			value_type reduce(double_value_type const& t) const;
+
+			// a * b * R^-1 mod n. b must be less than n, and a less than R.
+			value_type mul(value_type const& a, value_type const& b) const;
+
+			// a * a * R^-1 mod n. a must be less than n.
+			value_type sqr(value_type const& a) const;
+
+			void mul_assign(value_type& a, value_type const& b) const;
+			void sqr_assign(value_type& a) const;
+
+#pragma endregion
+
+		private:
+
+			static constexpr std::size_t s = value_type::block_count; // (as in montgomery_context)
+
+			// reduces t[0, 2s + 1), placing t * R^-1 mod n in t[s, 2s).
+			void reduce(block_t* t) const;
+
+			// subtracts n from t[0, s + 1) if t >= n.
+			void subtract_modulus(block_t* t) const;
+
+			value_type m_modulus;
+			value_type m_one; // R mod n
+			value_type m_r2; // R^2 mod n
+			block_t m_inverse; // -n^-1 mod b
+		};
+
+#pragma region members - constructors
+
+		template<std::size_t bits, class block_t>
+		fixed_montgomery_context<bits, block_t>::fixed_montgomery_context(value_type const& modulus):
+			m_modulus(modulus),
+			m_inverse(0u)
+		{
+			if (!m_modulus.get_bit(0u))
+				throw std::invalid_argument("montgomery modulus must be odd.");
+
+			m_inverse = montgomery_inverse(m_modulus.data()[0]);
+
+			// (only done once, so the general big_uint arithmetic is used)
+			auto const n = m_modulus.to_big_uint();
+
+			m_one = value_type((big_uint<block_t>(1u) <<= bits) % n);
+			m_r2 = value_type((big_uint<block_t>(1u) <<= (2u * bits)) % n);
+		}
+
+#pragma endregion
+
+#pragma region members - general
+
+		template<std::size_t bits, class block_t>
+		typename fixed_montgomery_context<bits, block_t>::value_type const& fixed_montgomery_context<bits, block_t>::modulus() const
+		{
+			return m_modulus;
+		}
+
+		template<std::size_t bits, class block_t>
+		typename fixed_montgomery_context<bits, block_t>::value_type fixed_montgomery_context<bits, block_t>::to_montgomery(value_type const& a) const
+		{
+			// (a < R and R^2 mod n < n, so a single multiplication by R^2 reduces fully)
+			return mul(a, m_r2);
+		}
+
+		template<std::size_t bits, class block_t>
+		typename fixed_montgomery_context<bits, block_t>::value_type fixed_montgomery_context<bits, block_t>::from_montgomery(value_type const& a) const
+		{
+			debug::die_if(a >= m_modulus);
+
+			auto t = std::array<block_t, 2u * s + 1u>{ };
+			std::copy(a.data().begin(), a.data().end(), t.begin());
+
+			reduce(t.data());
+
+			auto result = value_type();
+			std::copy(t.begin() + s, t.begin() + 2u * s, result.data().begin());
+
+			return result;
+		}
+
+		template<std::size_t bits, class block_t>
+		typename fixed_montgomery_context<bits, block_t>::value_type const& fixed_montgomery_context<bits, block_t>::one() const
+		{
+			return m_one;
+		}
+
+#pragma endregion
+
+#pragma region members - math
+
+		template<std::size_t bits, class block_t>
+		typename fixed_montgomery_context<bits, block_t>::value_type fixed_montgomery_context<bits, block_t>::reduce(double_value_type const& t) const
+		{
+			auto buffer = std::array<block_t, 2u * s + 1u>{ };
+			std::copy(t.data().begin(), t.data().end(), buffer.begin());
+
+			reduce(buffer.data());
+
+			auto result = value_type();
+			std::copy(buffer.begin() + s, buffer.begin() + 2u * s, result.data().begin());
+
+			return result;
+		}
+
+		template<std::size_t bits, class block_t>
+		typename fixed_montgomery_context<bits, block_t>::value_type fixed_montgomery_context<bits, block_t>::mul(value_type const& a, value_type const& b) const
+		{
+			using double_block_t = typename block_traits<block_t>::double_block_type;
+
+			debug::die_if(b >= m_modulus);
+
+			auto const n = m_modulus.data().data();
+
+			// interleaved multiplication and reduction (cios), as montgomery_context::mul_assign.
+			// the running total (before the shift) is less than 2bR, so each row only carries into the next two blocks.
+			auto t = std::array<block_t, 2u * s + 2u>{ };
+
+			for (auto i = std::size_t{ 0 }; i != s; ++i)
+			{
+				auto carry = ops::blocks::addmul_1(t.data() + i, b.data().data(), s, a.data()[i]);
+				auto overflow = ops::blocks::add_1(t.data() + i + s, t.data() + i + s, 2u, carry);
+				debug::die_if(overflow != 0u);
+
+				auto const m = static_cast<block_t>(static_cast<double_block_t>(t[i]) * m_inverse);
+				carry = ops::blocks::addmul_1(t.data() + i, n, s, m);
+				overflow = ops::blocks::add_1(t.data() + i + s, t.data() + i + s, 2u, carry);
+				debug::die_if(overflow != 0u);
+			}
+
+			debug::die_if(t[2u * s + 1u] != 0u);
+
+			subtract_modulus(t.data() + s);
+
+			auto result = value_type();
+			std::copy(t.begin() + s, t.begin() + 2u * s, result.data().begin());
+
+			return result;
+		}
+
+		template<std::size_t bits, class block_t>
+		typename fixed_montgomery_context<bits, block_t>::value_type fixed_montgomery_context<bits, block_t>::sqr(value_type const& a) const
+		{
+			debug::die_if(a >= m_modulus);
+
+			// square (calculating each cross product once), then reduce
+			auto t = std::array<block_t, 2u * s + 1u>{ };
+			ops::blocks::sqr_basecase(t.data(), a.data().data(), s);
+
+			reduce(t.data());
+
+			auto result = value_type();
+			std::copy(t.begin() + s, t.begin() + 2u * s, result.data().begin());
+
+			return result;
+		}
+
+		template<std::size_t bits, class block_t>
+		void fixed_montgomery_context<bits, block_t>::mul_assign(value_type& a, value_type const& b) const
+		{
+			a = mul(a, b);
+		}
+
+		template<std::size_t bits, class block_t>
+		void fixed_montgomery_context<bits, block_t>::sqr_assign(value_type& a) const
+		{
+			a = sqr(a);
+		}
+
+		template<std::size_t bits, class block_t>
+		void fixed_montgomery_context<bits, block_t>::reduce(block_t* t) const
+		{
+			using double_block_t = typename block_traits<block_t>::double_block_type;
+
+			auto const n = m_modulus.data().data();
+
+			for (auto i = std::size_t{ 0 }; i != s; ++i)
+			{
+				auto const m = static_cast<block_t>(static_cast<double_block_t>(t[i]) * m_inverse);
+				auto const carry = ops::blocks::addmul_1(t + i, n, s, m);
+				auto const overflow = ops::blocks::add_1(t + i + s, t + i + s, s + 1u - i, carry);
+				debug::die_if(overflow != 0u);
+			}
+
+			subtract_modulus(t + s);
+		}
+
+		template<std::size_t bits, class block_t>
+		void fixed_montgomery_context<bits, block_t>::subtract_modulus(block_t* t) const
+		{
+			auto const n = m_modulus.data().data();
+
+			// t < 2n, so at most one subtraction is needed
+			if (t[s] != 0u || ops::blocks::cmp(t, s, n, s) >= 0)
+			{
+				auto const borrow = ops::blocks::sub(t, t, s + 1u, n, s);
+				debug::die_if(borrow != 0u);
+			}
+
+			debug::die_if(t[s] != 0u);
+		}
+
+#pragma endregion
+
+	} // math
+
+} // rsa
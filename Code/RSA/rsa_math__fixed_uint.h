@@ -0,0 +1,281 @@
+#pragma once
+
+#include "rsa__debug.h"
+#include "rsa_math__big_uint.h"
+#include "rsa_math__utils.h"
+#include "rsa_math_ops__blocks.h"
+#include "rsa_math_ops__multiplication.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace rsa
+{
+
+	namespace math
+	{
+
+		// an unsigned integer with a fixed number of bits (a multiple of the block size), stored in a std::array.
+		// nothing is allocated, and the arithmetic always works on every block (there's no trimming), so the time
+		// taken depends only on the size. intended for operands with a size known in advance (e.g. rsa keys).
+		// addition and subtraction wrap modulo 2^bits.
+		template<std::size_t bits, class block_t = std::uint32_t>
+		class fixed_uint
+		{
+		public:
+
+			using block_type = block_t;
+
+			static constexpr std::size_t block_count = bits / utils::digits<block_type>();
+
+			using data_type = std::array<block_type, block_count>;
+			using bit_index_type = std::size_t;
+
+			static_assert(utils::is_uint_v<block_type>, "`block_type` must be an unsigned integer.");
+			static_assert(bits != 0u && bits % utils::digits<block_type>() == 0u, "`bits` must be a non-zero multiple of the block size.");
+
+#pragma region constructors
+
+			fixed_uint();
+
+			// throws std::range_error if n doesn't fit.
+			template<class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			explicit fixed_uint(uint_t n);
+
+			// throws std::range_error if n doesn't fit.
+			explicit fixed_uint(big_uint<block_type> const& n);
+
+#pragma endregion
+
+#pragma region general
+
+			big_uint<block_type> to_big_uint() const;
+
+			bool is_zero() const;
+
+			bool get_bit(bit_index_type i) const;
+			void set_bit(bit_index_type i, bool value);
+
+			data_type& data();
+			data_type const& data() const;
+
+#pragma endregion
+
+#pragma region math operators
+
+			fixed_uint& operator+=(fixed_uint const& b);
+			fixed_uint& operator-=(fixed_uint const& b);
+
+#pragma endregion
+
+		private:
+
+			data_type m_data;
+		};
+
+		namespace ops
+		{
+
+			// returns -1, 0 or 1 as a is less than, equal to or greater than b.
+			template<std::size_t bits, class block_t>
+			int cmp(fixed_uint<bits, block_t> const& a, fixed_uint<bits, block_t> const& b)
+			{
+				for (auto i = fixed_uint<bits, block_t>::block_count; i != 0u; --i)
+					if (a.data()[i - 1u] != b.data()[i - 1u])
+						return (a.data()[i - 1u] < b.data()[i - 1u]) ? -1 : 1;
+
+				return 0;
+			}
+
+			// out = a + b (mod 2^bits), returns the carry. out may be the same object as a or b.
+			template<std::size_t bits, class block_t>
+			block_t add(fixed_uint<bits, block_t>& out, fixed_uint<bits, block_t> const& a, fixed_uint<bits, block_t> const& b)
+			{
+				return blocks::add_n(out.data().data(), a.data().data(), b.data().data(), fixed_uint<bits, block_t>::block_count);
+			}
+
+			// out = a - b (mod 2^bits), returns the borrow. out may be the same object as a or b.
+			template<std::size_t bits, class block_t>
+			block_t sub(fixed_uint<bits, block_t>& out, fixed_uint<bits, block_t> const& a, fixed_uint<bits, block_t> const& b)
+			{
+				return blocks::sub_n(out.data().data(), a.data().data(), b.data().data(), fixed_uint<bits, block_t>::block_count);
+			}
+
+			// out = a * b (the full product, so twice the width).
+			// note: this is always schoolbook multiplication (karatsuba etc. would need scratch space).
+			template<std::size_t bits, class block_t>
+			void mul(fixed_uint<2u * bits, block_t>& out, fixed_uint<bits, block_t> const& a, fixed_uint<bits, block_t> const& b)
+			{
+				blocks::mul_basecase(out.data().data(), a.data().data(), a.data().size(), b.data().data(), b.data().size());
+			}
+
+			// out = a * a (the full product, so twice the width).
+			template<std::size_t bits, class block_t>
+			void sqr(fixed_uint<2u * bits, block_t>& out, fixed_uint<bits, block_t> const& a)
+			{
+				blocks::sqr_basecase(out.data().data(), a.data().data(), a.data().size());
+			}
+
+		} // ops
+
+#pragma region members - constructors
+
+		template<std::size_t bits, class block_t>
+		fixed_uint<bits, block_t>::fixed_uint():
+			m_data{ }
+		{
+
+		}
+
+		template<std::size_t bits, class block_t>
+		template<class uint_t, typename>
+		fixed_uint<bits, block_t>::fixed_uint(uint_t n):
+			fixed_uint()
+		{
+			auto const b = utils::to_blocks<block_t>(n);
+
+			if (b.size > block_count)
+				throw std::range_error("number is too large for fixed_uint.");
+
+			std::copy(b.blocks.begin(), b.blocks.begin() + b.size, m_data.begin());
+		}
+
+		template<std::size_t bits, class block_t>
+		fixed_uint<bits, block_t>::fixed_uint(big_uint<block_type> const& n):
+			fixed_uint()
+		{
+			if (n.data().size() > block_count)
+				throw std::range_error("number is too large for fixed_uint.");
+
+			std::copy(n.data().begin(), n.data().end(), m_data.begin());
+		}
+
+#pragma endregion
+
+#pragma region members - general
+
+		template<std::size_t bits, class block_t>
+		big_uint<block_t> fixed_uint<bits, block_t>::to_big_uint() const
+		{
+			return big_uint<block_t>(m_data.begin(), m_data.end());
+		}
+
+		template<std::size_t bits, class block_t>
+		bool fixed_uint<bits, block_t>::is_zero() const
+		{
+			return std::all_of(m_data.begin(), m_data.end(), [] (block_t b) { return b == block_t{ 0 }; });
+		}
+
+		template<std::size_t bits, class block_t>
+		bool fixed_uint<bits, block_t>::get_bit(bit_index_type i) const
+		{
+			debug::die_if(i >= bits);
+
+			return bool((m_data[i / utils::digits<block_t>()] >> (i % utils::digits<block_t>())) & 1u);
+		}
+
+		template<std::size_t bits, class block_t>
+		void fixed_uint<bits, block_t>::set_bit(bit_index_type i, bool value)
+		{
+			debug::die_if(i >= bits);
+
+			auto& block = m_data[i / utils::digits<block_t>()];
+			auto const mask = block_t(block_t{ 1u } << (i % utils::digits<block_t>()));
+
+			block = value ? block_t(block | mask) : block_t(block & block_t(~mask));
+		}
+
+		template<std::size_t bits, class block_t>
+		typename fixed_uint<bits, block_t>::data_type& fixed_uint<bits, block_t>::data()
+		{
+			return m_data;
+		}
+
+		template<std::size_t bits, class block_t>
+		typename fixed_uint<bits, block_t>::data_type const& fixed_uint<bits, block_t>::data() const
+		{
+			return m_data;
+		}
+
+#pragma endregion
+
+#pragma region members - math operators
+
+		template<std::size_t bits, class block_t>
+		fixed_uint<bits, block_t>& fixed_uint<bits, block_t>::operator+=(fixed_uint const& b)
+		{
+			ops::add(*this, *this, b);
+			return *this;
+		}
+
+		template<std::size_t bits, class block_t>
+		fixed_uint<bits, block_t>& fixed_uint<bits, block_t>::operator-=(fixed_uint const& b)
+		{
+			ops::sub(*this, *this, b);
+			return *this;
+		}
+
+#pragma endregion
+
+#pragma region comparison operators
+
+		template<std::size_t bits, class block_t>
+		bool operator==(fixed_uint<bits, block_t> const& a, fixed_uint<bits, block_t> const& b)
+		{
+			return (a.data() == b.data());
+		}
+
+		template<std::size_t bits, class block_t>
+		bool operator!=(fixed_uint<bits, block_t> const& a, fixed_uint<bits, block_t> const& b)
+		{
+			return !(a == b);
+		}
+
+		template<std::size_t bits, class block_t>
+		bool operator<(fixed_uint<bits, block_t> const& a, fixed_uint<bits, block_t> const& b)
+		{
+			return (ops::cmp(a, b) < 0);
+		}
+
+		template<std::size_t bits, class block_t>
+		bool operator>(fixed_uint<bits, block_t> const& a, fixed_uint<bits, block_t> const& b)
+		{
+			return (ops::cmp(a, b) > 0);
+		}
+
+		template<std::size_t bits, class block_t>
+		bool operator<=(fixed_uint<bits, block_t> const& a, fixed_uint<bits, block_t> const& b)
+		{
+			return (ops::cmp(a, b) <= 0);
+		}
+
+		template<std::size_t bits, class block_t>
+		bool operator>=(fixed_uint<bits, block_t> const& a, fixed_uint<bits, block_t> const& b)
+		{
+			return (ops::cmp(a, b) >= 0);
+		}
+
+#pragma endregion
+
+#pragma region math operators
+
+		template<std::size_t bits, class block_t>
+		fixed_uint<bits, block_t> operator+(fixed_uint<bits, block_t> a, fixed_uint<bits, block_t> const& b)
+		{
+			return a += b;
+		}
+
+		template<std::size_t bits, class block_t>
+		fixed_uint<bits, block_t> operator-(fixed_uint<bits, block_t> a, fixed_uint<bits, block_t> const& b)
+		{
+			return a -= b;
+		}
+
+#pragma endregion
+
+	} // math
+
+} // rsa
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "rsa_math__barrett.h"
+#include "rsa_math__big_uint.h"
+#include "rsa_math__montgomery.h"
+#include "rsa_math__workspace.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+namespace rsa
+{
+
+	namespace math
+	{
+
+		namespace mod_pow_detail
+		{
+
+			// the window width (in bits) that minimizes the number of multiplications for an exponent of the given size.
+			inline std::size_t window_bits(std::size_t exponent_bits)
+			{
+				if (exponent_bits <= 8u) return 1u;
+				if (exponent_bits <= 24u) return 2u;
+				if (exponent_bits <= 80u) return 3u;
+				if (exponent_bits <= 240u) return 4u;
+				if (exponent_bits <= 672u) return 5u;
+				if (exponent_bits <= 1792u) return 6u;
+				return 7u;
+			}
+
+			// left to right sliding window exponentiation. exp must not be zero.
+			// mul(a, b) sets a = a * b, and sqr(a) sets a = a * a (both in whatever representation base uses).
+			template<class block_t, class mul_t, class sqr_t>
+			big_uint<block_t> sliding_window(big_uint<block_t> const& base, big_uint<block_t> const& exp, mul_t mul, sqr_t sqr)
+			{
+				auto const bits = exp.get_most_significant_bit() + 1u;
+				auto const width = window_bits(bits);
+
+				// odd powers: base^1, base^3, ... base^(2^width - 1)
+				auto powers = std::pmr::vector<big_uint<block_t>>(std::size_t{ 1 } << (width - 1u), base.get_allocator().resource());
+				powers[0] = base;
+
+				if (powers.size() > 1u)
+				{
+					auto base_squared = base;
+					sqr(base_squared);
+
+					for (auto i = std::size_t{ 1 }; i != powers.size(); ++i)
+					{
+						powers[i] = powers[i - 1u];
+						mul(powers[i], base_squared);
+					}
+				}
+
+				// the result starts as 1, which is never multiplied or squared (so doesn't need to be in the same representation)
+				auto result = big_uint<block_t>(base.get_allocator());
+				auto is_one = true;
+
+				for (auto i = bits; i != 0u; )
+				{
+					if (!exp.get_bit(i - 1u))
+					{
+						if (!is_one) sqr(result);
+						--i;
+						continue;
+					}
+
+					// the longest window (up to width bits) starting at bit i - 1 that ends in a set bit
+					auto const low = (i >= width) ? (i - width) : std::size_t{ 0 };
+					auto end = low;
+
+					while (!exp.get_bit(end))
+						++end;
+
+					auto value = std::size_t{ 0 };
+
+					for (auto j = i; j != end; --j)
+					{
+						value = (value << 1u) | (exp.get_bit(j - 1u) ? 1u : 0u);
+
+						if (!is_one) sqr(result);
+					}
+
+					if (is_one)
+					{
+						result = powers[value >> 1u];
+						is_one = false;
+					}
+					else
+						mul(result, powers[value >> 1u]);
+
+					i = end;
+				}
+
+				return result;
+			}
+
+		} // mod_pow_detail
+
+		// (base ^ exp) mod context.modulus(), with base and the result in montgomery form. for several exponentiations with
+		// the same (odd) modulus, so the context is only set up once. temporary storage for the multiplications is taken from ws.
+		template<class block_t>
+		big_uint<block_t> mod_pow(montgomery_context<block_t> const& context, big_uint<block_t> const& base, big_uint<block_t> const& exp, workspace<block_t>& ws = default_workspace<block_t>())
+		{
+			if (exp.is_zero())
+				return big_uint<block_t>(context.one(), base.get_allocator());
+
+			return mod_pow_detail::sliding_window(base, exp,
+				[&] (big_uint<block_t>& a, big_uint<block_t> const& b) { context.mul_assign(a, b, ws); },
+				[&] (big_uint<block_t>& a) { context.sqr_assign(a, ws); });
+		}
+
+		// (base ^ exp) mod mod. uses montgomery multiplication for odd moduli, and barrett reduction for even ones.
+		// temporary storage for the multiplications is taken from ws.
+		template<class block_t>
+		big_uint<block_t> mod_pow(big_uint<block_t> const& base, big_uint<block_t> const& exp, big_uint<block_t> const& mod, workspace<block_t>& ws = default_workspace<block_t>())
+		{
+			if (mod.is_zero())
+				throw std::invalid_argument("modulus cannot be zero.");
+
+			if (mod == 1u)
+				return big_uint<block_t>(base.get_allocator());
+
+			if (exp.is_zero())
+				return big_uint<block_t>(1u, base.get_allocator());
+
+			if (mod.get_bit(0u))
+			{
+				auto const context = montgomery_context<block_t>(mod);
+				return context.from_montgomery(mod_pow(context, context.to_montgomery(base, ws), exp, ws), ws);
+			}
+
+			auto const context = barrett_context<block_t>(mod);
+
+			auto reduced_base = base;
+			context.reduce(reduced_base, ws);
+
+			return mod_pow_detail::sliding_window(reduced_base, exp,
+				[&] (big_uint<block_t>& a, big_uint<block_t> const& b) { context.mul_assign(a, b, ws); },
+				[&] (big_uint<block_t>& a) { context.sqr_assign(a, ws); });
+		}
+
+	} // math
+
+} // rsa
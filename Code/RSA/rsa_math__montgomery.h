@@ -0,0 +1,318 @@
+#pragma once
+
+#include "rsa__debug.h"
+#include "rsa_math__big_uint.h"
+#include "rsa_math__utils.h"
+#include "rsa_math__workspace.h"
+#include "rsa_math_ops__blocks.h"
+#include "rsa_math_ops__multiplication.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace rsa
+{
+
+	namespace math
+	{
+
+		// -n0^-1 mod b, for an odd block n0 (the lowest block of a montgomery modulus).
+		template<class block_t>
+		block_t montgomery_inverse(block_t n0)
+		{
+			using double_block_t = typename block_traits<block_t>::double_block_type;
+
+			debug::die_if((n0 & 1u) == 0u);
+
+			// newton's method for the inverse mod b. n0 is its own inverse mod 8, and each step doubles the number of correct bits.
+			auto inverse = n0;
+
+			for (auto bits = 3u; bits < utils::digits<block_t>(); bits *= 2u)
+			{
+				auto const e = static_cast<block_t>(static_cast<double_block_t>(n0) * inverse);
+				inverse = static_cast<block_t>(static_cast<double_block_t>(inverse) * static_cast<block_t>(block_t{ 2 } - e));
+			}
+
+			debug::die_if(static_cast<block_t>(static_cast<double_block_t>(n0) * inverse) != block_t{ 1 });
+
+			return static_cast<block_t>(block_t{ 0 } - inverse);
+		}
+
+		// precomputed values for montgomery multiplication modulo an odd number n.
+		// with R = b^s (where s is the number of blocks in n), values are stored in "montgomery form" (a * R mod n),
+		// and multiplied with a reduction step that only needs block multiplications and shifts, instead of a division.
+		template<class block_t>
+		class montgomery_context
+		{
+		public:
+
+			using block_type = block_t;
+			using value_type = big_uint<block_t>;
+
+#pragma region constructors
+
+			explicit montgomery_context(value_type modulus);
+
+#pragma endregion
+
+#pragma region general
+
+			value_type const& modulus() const;
+
+			// a * R mod n. a may be larger than n.
+			value_type to_montgomery(value_type const& a, workspace<block_t>& ws = default_workspace<block_t>()) const;
+
+			// a * R^-1 mod n. a must be less than n.
+			value_type from_montgomery(value_type const& a, workspace<block_t>& ws = default_workspace<block_t>()) const;
+
+			// 1 in montgomery form (R mod n).
+			value_type const& one() const;
+
+#pragma endregion
+
+#pragma region math
+
+			// a = a * b * R^-1 mod n. a and b must be less than n (e.g. both in montgomery form). a and b may be the same object.
+			// temporary storage is taken from ws.
+			void mul_assign(value_type& a, value_type const& b, workspace<block_t>& ws = default_workspace<block_t>()) const;
+
+			// a = a * a * R^-1 mod n. a must be less than n.
+			void sqr_assign(value_type& a, workspace<block_t>& ws = default_workspace<block_t>()) const;
+
+			value_type mul(value_type a, value_type const& b) const;
+			value_type sqr(value_type a) const;
+
+#pragma endregion
+
+		private:
+
+			// reduces t[0, 2s + 1), placing t * R^-1 mod n in t[s, 2s).
+			void reduce(block_t* t) const;
+
+			// subtracts n from t[0, s + 1) if t >= n.
+			void subtract_modulus(block_t* t) const;
+
+			value_type m_modulus;
+			value_type m_one; // R mod n
+			value_type m_r2; // R^2 mod n
+			block_t m_inverse; // -n^-1 mod b
+		};
+
+#pragma region members - constructors
+
+		template<class block_t>
+		montgomery_context<block_t>::montgomery_context(value_type modulus):
+			m_modulus(std::move(modulus)),
+			m_one(m_modulus.get_allocator()),
+			m_r2(m_modulus.get_allocator()),
+			m_inverse(0u)
+		{
+			if (m_modulus.is_zero() || !m_modulus.get_bit(0u))
+				throw std::invalid_argument("montgomery modulus must be odd.");
+
+			auto const s = m_modulus.data().size();
+
+			m_inverse = montgomery_inverse(m_modulus.data()[0]);
+
+			m_one = (value_type(1u, m_modulus.get_allocator()) <<= (s * utils::digits<block_t>()));
+			m_one %= m_modulus;
+
+			m_r2 = (value_type(1u, m_modulus.get_allocator()) <<= (2u * s * utils::digits<block_t>()));
+			m_r2 %= m_modulus;
+		}
+
+#pragma endregion
+
+#pragma region members - general
+
+		template<class block_t>
+		typename montgomery_context<block_t>::value_type const& montgomery_context<block_t>::modulus() const
+		{
+			return m_modulus;
+		}
+
+		template<class block_t>
+		typename montgomery_context<block_t>::value_type montgomery_context<block_t>::to_montgomery(value_type const& a, workspace<block_t>& ws) const
+		{
+			auto result = a;
+
+			if (result >= m_modulus)
+				ops::mod_assign(result, m_modulus, ws);
+
+			mul_assign(result, m_r2, ws);
+			return result;
+		}
+
+		template<class block_t>
+		typename montgomery_context<block_t>::value_type montgomery_context<block_t>::from_montgomery(value_type const& a, workspace<block_t>& ws) const
+		{
+			debug::die_if(a >= m_modulus);
+
+			auto const s = m_modulus.data().size();
+
+			auto frame = typename workspace<block_t>::frame(ws);
+			auto const t = frame.allocate(2u * s + 1u);
+			std::copy(a.data().begin(), a.data().end(), t);
+
+			reduce(t);
+
+			auto result = value_type(t + s, t + 2u * s, a.get_allocator());
+			utils::trim(result);
+
+			return result;
+		}
+
+		template<class block_t>
+		typename montgomery_context<block_t>::value_type const& montgomery_context<block_t>::one() const
+		{
+			return m_one;
+		}
+
+#pragma endregion
+
+#pragma region members - math
+
+		template<class block_t>
+		void montgomery_context<block_t>::mul_assign(value_type& a, value_type const& b, workspace<block_t>& ws) const
+		{
+			using double_block_t = typename block_traits<block_t>::double_block_type;
+
+			if (&a == &b)
+				return sqr_assign(a, ws);
+
+			debug::die_if(a >= m_modulus);
+			debug::die_if(b >= m_modulus);
+
+			if (a.is_zero() || b.is_zero())
+			{
+				a.data().clear();
+				return;
+			}
+
+			auto const s = m_modulus.data().size();
+			auto const n = m_modulus.data().data();
+
+			auto const& a_data = a.data();
+			auto const& b_data = b.data();
+
+			auto frame = typename workspace<block_t>::frame(ws);
+
+			// for large moduli, the product can use a faster multiplication algorithm, leaving only the reduction quadratic
+			if (s >= ops::thresholds().karatsuba)
+			{
+				auto const t = frame.allocate(2u * s + 1u);
+				ops::blocks::mul(t, a_data.data(), a_data.size(), b_data.data(), b_data.size(), ws);
+
+				reduce(t);
+
+				a.data().assign(t + s, t + 2u * s);
+				utils::trim(a);
+				return;
+			}
+
+			// interleaved multiplication and reduction (cios). each row adds a[i] * b, then m * n to clear block i.
+			// rather than shifting t down a block after each row, the next row starts one block higher.
+			// the running total (before the shift) is less than 2bn, so needs s + 2 blocks.
+			auto const t = frame.allocate(2u * s + 2u);
+
+			for (auto i = std::size_t{ 0 }; i != s; ++i)
+			{
+				if (i < a_data.size())
+				{
+					auto const carry = ops::blocks::addmul_1(t + i, b_data.data(), b_data.size(), a_data[i]);
+					auto const overflow = ops::blocks::add_1(t + i + b_data.size(), t + i + b_data.size(), s + 2u - b_data.size(), carry);
+					debug::die_if(overflow != 0u);
+				}
+
+				auto const m = static_cast<block_t>(static_cast<double_block_t>(t[i]) * m_inverse);
+				auto const carry = ops::blocks::addmul_1(t + i, n, s, m);
+				auto const overflow = ops::blocks::add_1(t + i + s, t + i + s, s + 2u - i, carry);
+				debug::die_if(overflow != 0u);
+			}
+
+			debug::die_if(t[2u * s + 1u] != 0u);
+
+			subtract_modulus(t + s);
+
+			a.data().assign(t + s, t + 2u * s);
+			utils::trim(a);
+		}
+
+		template<class block_t>
+		void montgomery_context<block_t>::sqr_assign(value_type& a, workspace<block_t>& ws) const
+		{
+			debug::die_if(a >= m_modulus);
+
+			if (a.is_zero())
+				return;
+
+			auto const s = m_modulus.data().size();
+			auto const& a_data = a.data();
+
+			// square (calculating each cross product once), then reduce
+			auto frame = typename workspace<block_t>::frame(ws);
+			auto const t = frame.allocate(2u * s + 1u);
+			ops::blocks::sqr_n(t, a_data.data(), a_data.size(), ws);
+
+			reduce(t);
+
+			a.data().assign(t + s, t + 2u * s);
+			utils::trim(a);
+		}
+
+		template<class block_t>
+		typename montgomery_context<block_t>::value_type montgomery_context<block_t>::mul(value_type a, value_type const& b) const
+		{
+			mul_assign(a, b);
+			return a;
+		}
+
+		template<class block_t>
+		typename montgomery_context<block_t>::value_type montgomery_context<block_t>::sqr(value_type a) const
+		{
+			sqr_assign(a);
+			return a;
+		}
+
+		template<class block_t>
+		void montgomery_context<block_t>::reduce(block_t* t) const
+		{
+			using double_block_t = typename block_traits<block_t>::double_block_type;
+
+			auto const s = m_modulus.data().size();
+			auto const n = m_modulus.data().data();
+
+			for (auto i = std::size_t{ 0 }; i != s; ++i)
+			{
+				auto const m = static_cast<block_t>(static_cast<double_block_t>(t[i]) * m_inverse);
+				auto const carry = ops::blocks::addmul_1(t + i, n, s, m);
+				auto const overflow = ops::blocks::add_1(t + i + s, t + i + s, s + 1u - i, carry);
+				debug::die_if(overflow != 0u);
+			}
+
+			subtract_modulus(t + s);
+		}
+
+		template<class block_t>
+		void montgomery_context<block_t>::subtract_modulus(block_t* t) const
+		{
+			auto const s = m_modulus.data().size();
+			auto const n = m_modulus.data().data();
+
+			// t < 2n, so at most one subtraction is needed
+			if (ops::blocks::cmp(t, s + 1u, n, s) >= 0)
+			{
+				auto const borrow = ops::blocks::sub(t, t, s + 1u, n, s);
+				debug::die_if(borrow != 0u);
+			}
+
+			debug::die_if(t[s] != 0u);
+		}
+
+#pragma endregion
+
+	} // math
+
+} // rsa
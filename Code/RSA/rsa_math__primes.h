@@ -1,11 +1,27 @@
 #pragma once
 
 #include "rsa_math__big_uint.h"
+#include "rsa_math__expressions.h"
+#include "rsa_math__mod_pow.h"
+#include "rsa_math__montgomery.h"
+#include "rsa_math__workspace.h"
+#include "rsa_math_ops__division.h"
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <memory_resource>
 #include <random>
-#include <set>
+#include <utility>
+#include <vector>
+
+// the number of small primes (2, 3, 5, ...) that is_prime_rm trial divides by before the miller-rabin rounds.
+// 0 picks a number based on the size of the number tested (see trial_division_prime_count()).
+// may also be changed at runtime with trial_division_primes().
+#ifndef RSA_MATH_TRIAL_DIVISION_PRIMES
+#define RSA_MATH_TRIAL_DIVISION_PRIMES 0
+#endif
 
 namespace rsa
 {
@@ -27,6 +43,129 @@ namespace rsa
 			467, 479, 487, 491, 499, 503, 509, 521, 523, 541, 
 		}};
 
+		// the odd primes below 2^16, for sieving prime candidates (calculated once).
+		inline std::vector<std::uint32_t> const& sieve_primes()
+		{
+			static auto const primes = [] ()
+			{
+				constexpr auto limit = std::uint32_t{ 1u } << 16u;
+
+				auto composite = std::vector<bool>(limit, false);
+				auto result = std::vector<std::uint32_t>();
+
+				for (auto i = std::uint32_t{ 3 }; i < limit; i += 2u)
+				{
+					if (composite[i])
+						continue;
+
+					result.push_back(i);
+
+					for (auto j = i * i; j < limit; j += 2u * i)
+						composite[j] = true;
+				}
+
+				return result;
+			}();
+
+			return primes;
+		}
+
+		// runtime tuning knob (see RSA_MATH_TRIAL_DIVISION_PRIMES). at most sieve_primes().size() + 1 primes are used.
+		// note: this isn't synchronized.
+		inline std::size_t& trial_division_primes()
+		{
+			static auto value = std::size_t{ RSA_MATH_TRIAL_DIVISION_PRIMES };
+			return value;
+		}
+
+		// sets trial_division_primes() until destroyed, then restores the previous value.
+		class scoped_trial_division_primes
+		{
+		public:
+
+			explicit scoped_trial_division_primes(std::size_t value):
+				m_previous(std::exchange(trial_division_primes(), value))
+			{
+
+			}
+
+			scoped_trial_division_primes(scoped_trial_division_primes const&) = delete;
+			scoped_trial_division_primes& operator=(scoped_trial_division_primes const&) = delete;
+
+			~scoped_trial_division_primes()
+			{
+				trial_division_primes() = m_previous;
+			}
+
+		private:
+
+			std::size_t m_previous;
+		};
+
+		// the number of primes is_prime_rm trial divides a number of num_bits by.
+		inline std::size_t trial_division_prime_count(std::size_t num_bits)
+		{
+			if (trial_division_primes() != 0u)
+				return trial_division_primes();
+
+			// (roughly the fastest counts in BM_RSA_is_prime_rm_trial_division_32: ~300 up to 512 bits, ~3000 at 2048 bits)
+			return std::clamp<std::size_t>(num_bits + num_bits / 2u, 300u, 3000u);
+		}
+
+		// returns the smallest of the first count primes (2, then sieve_primes()) that divides n, or 0 if none do.
+		// consecutive primes are multiplied into block-sized divisors, and the remainders of a batch of divisors are found
+		// in one pass over n, then split into the remainders of each prime.
+		template<class block_t>
+		std::uint32_t find_small_factor(big_uint_view<block_t> n, std::size_t count)
+		{
+			constexpr auto batch_size = std::size_t{ 16 };
+
+			auto const& primes = sieve_primes();
+			auto const prime = [&] (std::size_t i) { return (i == 0u) ? std::uint32_t{ 2 } : primes[i - 1u]; };
+
+			count = std::min(count, primes.size() + 1u);
+
+			auto divisors = std::array<block_t, batch_size>{ };
+			auto remainders = std::array<block_t, batch_size>{ };
+			auto ends = std::array<std::size_t, batch_size>{ }; // one past the last prime in each divisor
+
+			for (auto i = std::size_t{ 0 }; i != count; )
+			{
+				auto const first = i;
+				auto batch = std::size_t{ 0 };
+
+				while (batch != batch_size && i != count && prime(i) <= utils::max<block_t>())
+				{
+					auto d = static_cast<block_t>(prime(i++));
+
+					while (i != count && d <= utils::max<block_t>() / prime(i))
+						d = static_cast<block_t>(d * prime(i++));
+
+					divisors[batch] = d;
+					ends[batch++] = i;
+				}
+
+				// (primes that don't fit in a block use the general division)
+				if (batch == 0u)
+				{
+					if (ops::mod(n, prime(i)) == 0u)
+						return prime(i);
+
+					++i;
+					continue;
+				}
+
+				ops::blocks::mod_1_n(remainders.data(), n.data().data(), n.data().size(), divisors.data(), batch);
+
+				for (auto b = std::size_t{ 0 }, j = first; b != batch; ++b)
+					for (; j != ends[b]; ++j)
+						if (remainders[b] % prime(j) == 0u)
+							return prime(j);
+			}
+
+			return 0u;
+		}
+
 		// TODO: move to .cpp
 		inline bool is_prime(std::uint64_t n)
 		{
@@ -48,152 +187,559 @@ namespace rsa
 		template<class block_t>
 		bool is_prime(math::big_uint<block_t> const& n)
 		{
-			if (n % 2u == 0u)
+			if (ops::mod(n, 2u) == 0u)
 				return n == 2u;
 
-			if (n % 3u == 0u)
+			if (ops::mod(n, 3u) == 0u)
 				return n == 3u;
 
-			for (auto k = math::big_uint<block_t>(6u); (k - 1u) * (k - 1u) <= n; k += 6u)
+			using expr::lazy;
+
+			// (the expressions calculate the square and remainders in the workspace, without temporary big_uints)
+			for (auto k = math::big_uint<block_t>(6u, n.get_allocator()); (lazy(k) - 1u) * (lazy(k) - 1u) <= n; k += 6u)
 			{
-				if (n % (k - 1u) == 0u || n % (k + 1u) == 0u)
+				if (lazy(n) % (lazy(k) - 1u) == 0u || lazy(n) % (lazy(k) + 1u) == 0u)
 					return false;
 			}
 
 			return true;
 		}
 
+		// the result's blocks are allocated with allocator.
 		template<class block_t>
-		bool is_prime_rm(math::big_uint<block_t> const& n, std::mt19937_64& rng, std::size_t k)
+		math::big_uint<block_t> generate_random_bits(std::mt19937_64& rng, std::size_t num_bits, typename math::big_uint<block_t>::allocator_type const& allocator = { })
+		{
+			auto result = math::big_uint<block_t>(allocator);
+
+			if (num_bits == 0u)
+				return result;
+
+			auto blocks = num_bits / utils::digits<block_t>();
+			result.data().resize(blocks + 1u);
+			
+			auto dist = std::uniform_int_distribution<block_t>(0u, utils::max<block_t>());
+
+			for (auto& block : result.data())
+				block = dist(rng);
+
+			// replace the number in the last block with one that doesn't go over num_bits
+			auto final_bits = num_bits - (utils::digits<block_t>() * (result.data().size() - 1u));
+			auto final_dist = std::uniform_int_distribution<block_t>(0u, block_t{ 1u } << final_bits);
+			result.data().back() = final_dist(rng);
+
+			utils::trim(result);
+
+			return result;
+		}
+
+		// miller-rabin rounds for an odd number n > 3. n - 1 = 2^s * m and the montgomery context for n are set up once,
+		// and shared by every round.
+		template<class block_t>
+		class miller_rabin
+		{
+		public:
+
+			using block_type = block_t;
+			using value_type = big_uint<block_t>;
+
+#pragma region constructors
+
+			explicit miller_rabin(value_type const& n);
+
+#pragma endregion
+
+#pragma region general
+
+			value_type const& n() const;
+			montgomery_context<block_t> const& context() const;
+
+			// whether n is a strong probable prime to base a (i.e. a isn't a witness that n is composite). a must be in [2, n - 2].
+			// temporary storage for the arithmetic is taken from ws.
+			bool test(value_type const& a, workspace<block_t>& ws = default_workspace<block_t>()) const;
+
+			// test(2), with the multiplications by the base in the exponentiation replaced by doubling (a shift and a
+			// conditional subtraction), which is cheaper than a montgomery multiplication.
+			bool test_base_2(workspace<block_t>& ws = default_workspace<block_t>()) const;
+
+#pragma endregion
+
+		private:
+
+			// the rest of a round, from x = a^m (in montgomery form).
+			bool test_squares(value_type& x, workspace<block_t>& ws) const;
+
+			// x = 2x mod n.
+			void double_mod(value_type& x) const;
+
+			montgomery_context<block_t> m_context;
+			value_type m_m;
+			std::size_t m_s;
+			value_type m_minus_one; // n - 1 in montgomery form
+		};
+
+		// miller-rabin test with the given bases (big_uints or unsigned integers). bases that are 0, 1 or -1 mod n are skipped.
+		// temporary storage for the arithmetic is taken from ws, and temporary numbers use the allocator of n.
+		template<class block_t, class bases_t>
+		bool is_strong_probable_prime(math::big_uint<block_t> const& n, bases_t const& bases, workspace<block_t>& ws = default_workspace<block_t>())
+		{
+			if (n < 4u)
+				return n >= 2u;
+
+			if (!n.get_bit(0u))
+				return false;
+
+			auto const rounds = miller_rabin<block_t>(n);
+			auto const n_minus_one = n - 1u;
+
+			for (auto const& base : bases)
+			{
+				auto a = math::big_uint<block_t>(base, n.get_allocator());
+				ops::mod_assign(a, n, ws);
+
+				if (a <= 1u || a == n_minus_one)
+					continue;
+
+				if (!(a == 2u ? rounds.test_base_2(ws) : rounds.test(a, ws)))
+					return false;
+			}
+
+			return true;
+		}
+
+		// miller-rabin test with k random bases, without trial division (e.g. for numbers that were already sieved).
+		// if base_2, the first of the k rounds uses base 2 instead (see miller_rabin::test_base_2). temporary storage for the
+		// arithmetic is taken from ws. temporary numbers use the allocator of n.
+		template<class block_t>
+		bool is_probable_prime_rm(math::big_uint<block_t> const& n, std::mt19937_64& rng, std::size_t k, workspace<block_t>& ws = default_workspace<block_t>(), bool base_2 = false)
+		{
+			if (n < 4u)
+				return n >= 2u;
+
+			if (!n.get_bit(0u))
+				return false;
+
+			auto const rounds = miller_rabin<block_t>(n);
+
+			if (base_2 && k != 0u)
+			{
+				if (!rounds.test_base_2(ws))
+					return false;
+
+				--k;
+			}
+
+			// (random bases of msb bits are almost always in [2, n - 2], so rejection is rare)
+			auto const num_bits = n.get_most_significant_bit();
+			auto const n_minus_one = n - 1u;
+
+			for (auto i = std::size_t{ 0 }; i != k; )
+			{
+				auto const a = generate_random_bits<block_t>(rng, num_bits, n.get_allocator());
+
+				if (a < 2u || a >= n_minus_one)
+					continue;
+
+				if (!rounds.test(a, ws))
+					return false;
+
+				++i;
+			}
+
+			return true;
+		}
+
+		// trial division, then is_probable_prime_rm (k random bases). temporary storage for the arithmetic is taken from ws.
+		// temporary numbers use the allocator of n.
+		template<class block_t>
+		bool is_prime_rm(math::big_uint<block_t> const& n, std::mt19937_64& rng, std::size_t k, workspace<block_t>& ws = default_workspace<block_t>())
 		{
 			if (n == 0u)
 				return false;
 
-			if (n == 1u)
+			if (n < 4u)
 				return true;
 
-			for (auto i = 0u; i != first_100_primes.size(); ++i)
-				if (n % first_100_primes[i] == 0u)
-					return n == first_100_primes[i];
-
-			auto m = n - 1u;
-			auto s = 0u;
+			if (auto const p = find_small_factor<block_t>(n, trial_division_prime_count(n.get_most_significant_bit() + 1u)); p != 0u)
+				return n == p;
 
-			while (m % 2u == 0u) { s += 1u; m /= 2u; }
+			return is_probable_prime_rm(n, rng, k, ws);
+		}
 
-			auto liars = std::set<math::big_uint<block_t>>();
+		namespace primes_detail
+		{
 
-			auto get_new_x = [&] ()
+			// jacobi symbol (a / n) for odd n (binary algorithm: factors of 2 are shifted out, then the symbol is flipped with
+			// quadratic reciprocity and reduced).
+			inline int jacobi(std::uint64_t a, std::uint64_t n)
 			{
-				auto num_bits = n.get_most_significant_bit();
+				debug::die_if((n & 1u) == 0u);
 
-				while (true)
+				auto result = 1;
+				a %= n;
+
+				while (a != 0u)
 				{
-					auto x = generate_random_bits<block_t>(rng, num_bits);
+					while ((a & 1u) == 0u)
+					{
+						a >>= 1u;
 
-					if (x > 2u && x < n && liars.count(x) == 0u)
-						return x;
+						if ((n & 7u) == 3u || (n & 7u) == 5u)
+							result = -result;
+					}
+
+					std::swap(a, n);
+
+					if ((a & 3u) == 3u && (n & 3u) == 3u)
+						result = -result;
+
+					a %= n;
 				}
 
-				debug::die();
-				return math::big_uint<block_t>();
-			};
+				return (n == 1u) ? result : 0;
+			}
 
-			auto power = [] (math::big_uint<block_t> x, math::big_uint<block_t> m, math::big_uint<block_t> const& n)
+			// a = a / 2 mod n (n odd).
+			template<class block_t>
+			void half_mod(big_uint<block_t>& a, big_uint<block_t> const& n)
 			{
-				auto a = math::big_uint<block_t>(1u);
+				if (a.get_bit(0u))
+					a += n;
 
-				while (m > 0u)
-				{
-					if (m % 2u == 1u)
-						a = (a * x) % n;
-					x = (x * x) % n;
-					m /= 2u;
-				}
+				a >>= 1u;
+			}
 
-				return a;
-			};
+			// a = a + b mod n (a and b less than n).
+			template<class block_t>
+			void add_mod(big_uint<block_t>& a, big_uint<block_t> const& b, big_uint<block_t> const& n)
+			{
+				a += b;
+
+				if (a >= n)
+					a -= n;
+			}
+
+			// a = a - b mod n (a and b less than n).
+			template<class block_t>
+			void sub_mod(big_uint<block_t>& a, big_uint<block_t> const& b, big_uint<block_t> const& n)
+			{
+				if (a < b)
+					a += n;
+
+				a -= b;
+			}
 
-			while (liars.size() != k)
+			// a = a * c mod n (a less than n). works in or out of montgomery form.
+			template<class block_t>
+			void mul_mod(big_uint<block_t>& a, std::int64_t c, big_uint<block_t> const& n, workspace<block_t>& ws)
 			{
-				auto x = get_new_x();
-				auto xi = power(x, m, n);
+				a *= static_cast<std::uint64_t>(c < 0 ? -c : c);
+				ops::mod_assign(a, n, ws);
 
-				auto witness = true;
+				if (c < 0 && !a.is_zero())
+					a = n - std::move(a);
+			}
 
-				if (xi == 1u || xi == n - 1u)
-					witness = false;
-				else
+			// strong lucas probable prime test of context.modulus() (n), with P = 1 and Q = (1 - d) / 4, where (d / n) = -1.
+			template<class block_t>
+			bool is_strong_lucas_probable_prime(montgomery_context<block_t> const& context, std::int64_t d, workspace<block_t>& ws)
+			{
+				auto const& n = context.modulus();
+				auto const q_value = (1 - d) / 4;
+
+				// n + 1 = k * 2^s
+				auto k = n + 1u;
+				auto const s = k.get_least_significant_bit();
+				k >>= s;
+
+				// (in montgomery form) U_1 = 1, V_1 = P = 1, Q^1
+				auto u = context.one();
+				auto v = context.one();
+				auto q = context.one();
+				mul_mod(q, q_value, n, ws);
+				auto qk = q;
+
+				for (auto i = k.get_most_significant_bit(); i != 0u; )
 				{
-					for (auto i = math::big_uint<block_t>(0u); i != s - 1u; ++i)
+					--i;
+
+					// U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k
+					context.mul_assign(u, v, ws);
+					context.sqr_assign(v, ws);
+					sub_mod(v, qk, n);
+					sub_mod(v, qk, n);
+					context.sqr_assign(qk, ws);
+
+					if (k.get_bit(i))
 					{
-						xi = (xi * xi) % n;
-
-						if (xi == 1u)
-							return false;
-						else if (xi == n - 1u)
-						{
-							witness = false;
-							break;
-						}
+						// U_2k+1 = (P U_2k + V_2k) / 2, V_2k+1 = (d U_2k + P V_2k) / 2
+						auto du = u;
+						mul_mod(du, d, n, ws);
+
+						add_mod(u, v, n);
+						half_mod(u, n);
+
+						add_mod(v, du, n);
+						half_mod(v, n);
+
+						context.mul_assign(qk, q, ws);
 					}
+				}
+
+				if (u.is_zero() || v.is_zero())
+					return true;
+
+				// V_(k 2^r) for r in [1, s)
+				for (auto r = std::size_t{ 1 }; r < s; ++r)
+				{
+					context.sqr_assign(v, ws);
+					sub_mod(v, qk, n);
+					sub_mod(v, qk, n);
+
+					if (v.is_zero())
+						return true;
+
+					context.sqr_assign(qk, ws);
+				}
+
+				return false;
+			}
+
+		} // primes_detail
+
+		// jacobi symbol (d / n) for odd n.
+		template<class block_t>
+		int jacobi(std::int64_t d, big_uint<block_t> const& n)
+		{
+			debug::die_if(!n.get_bit(0u));
+
+			auto const n_mod_8 = ops::mod(n, 8u);
+			auto a = static_cast<std::uint64_t>(d < 0 ? -d : d);
+			auto result = 1;
+
+			// (-1 / n) = -1 if n = 3 mod 4
+			if (d < 0 && (n_mod_8 & 3u) == 3u)
+				result = -result;
+
+			if (a == 0u)
+				return (n == 1u) ? 1 : 0;
+
+			// (2 / n) = -1 if n = 3 or 5 mod 8
+			while ((a & 1u) == 0u)
+			{
+				a >>= 1u;
+
+				if (n_mod_8 == 3u || n_mod_8 == 5u)
+					result = -result;
+			}
+
+			// (a / n) = (n mod a / a), negated if a and n are both 3 mod 4
+			if ((a & 3u) == 3u && (n_mod_8 & 3u) == 3u)
+				result = -result;
+
+			return result * primes_detail::jacobi(ops::mod(n, a), a);
+		}
+
+		// whether n is a perfect square (with newton's method for floor(sqrt(n))).
+		template<class block_t>
+		bool is_square(big_uint<block_t> const& n)
+		{
+			if (n.is_zero())
+				return true;
+
+			// (squares are 0, 1, 4 or 9 mod 16)
+			auto const r = ops::mod(n, 16u);
+
+			if (r != 0u && r != 1u && r != 4u && r != 9u)
+				return false;
+
+			auto x = (big_uint<block_t>(1u, n.get_allocator()) <<= (n.get_most_significant_bit() / 2u + 1u));
+
+			while (true)
+			{
+				auto y = ((n / x) += x) >>= 1u;
+
+				if (y >= x)
+					break;
+
+				x = std::move(y);
+			}
+
+			return (x * x == n);
+		}
 
-					xi = (xi * xi) % n;
+		// strong lucas probable prime test of n = context.modulus() (odd, and greater than 3), with selfridge's parameters (the
+		// first d in 5, -7, 9, -11, ... with (d / n) = -1, P = 1, Q = (1 - d) / 4). temporary storage for the arithmetic is taken from ws.
+		template<class block_t>
+		bool is_strong_lucas_probable_prime(montgomery_context<block_t> const& context, workspace<block_t>& ws = default_workspace<block_t>())
+		{
+			auto const& n = context.modulus();
+
+			auto d = std::int64_t{ 5 };
+
+			for (auto i = 0u; ; ++i)
+			{
+				auto const j = jacobi(d, n);
+
+				if (j == -1)
+					break;
 
-					if (xi != 1u)
-						return false;
+				// d and n share a factor
+				if (j == 0)
+				{
+					auto const abs_d = static_cast<std::uint64_t>(d < 0 ? -d : d);
+					return (n == abs_d && is_prime(abs_d));
 				}
 
-				if (witness)
+				// (there's no such d for squares, so check for one if it's taking a while)
+				if (i == 8u && is_square(n))
 					return false;
-				else
-					liars.insert(x);
+
+				d = (d > 0) ? -(d + 2) : -(d - 2);
 			}
 
-			return true;
+			return primes_detail::is_strong_lucas_probable_prime(context, d, ws);
 		}
 
+		// as above, for any n.
 		template<class block_t>
-		math::big_uint<block_t> generate_random_bits(std::mt19937_64& rng, std::size_t num_bits)
+		bool is_strong_lucas_probable_prime(big_uint<block_t> const& n, workspace<block_t>& ws = default_workspace<block_t>())
 		{
-			auto result = math::big_uint<block_t>();
+			if (n < 4u)
+				return n >= 2u;
 
-			if (num_bits == 0u)
-				return result;
+			if (!n.get_bit(0u))
+				return false;
 
-			auto blocks = num_bits / utils::digits<block_t>();
-			result.data().resize(blocks + 1u);
-			
-			auto dist = std::uniform_int_distribution<block_t>(0u, utils::max<block_t>());
+			return is_strong_lucas_probable_prime(montgomery_context<block_t>(n), ws);
+		}
 
-			for (auto& block : result.data())
-				block = dist(rng);
+		// baillie-psw test: trial division, a base 2 strong probable prime test, then a strong lucas probable prime test.
+		// (no composite number passing it is known.) temporary storage for the arithmetic is taken from ws.
+		template<class block_t>
+		bool is_prime_bpsw(big_uint<block_t> const& n, workspace<block_t>& ws = default_workspace<block_t>())
+		{
+			if (n < 4u)
+				return n >= 2u;
 
-			// replace the number in the last block with one that doesn't go over num_bits
-			auto final_bits = num_bits - (utils::digits<block_t>() * (result.data().size() - 1u));
-			auto final_dist = std::uniform_int_distribution<block_t>(0u, block_t{ 1u } << final_bits);
-			result.data().back() = final_dist(rng);
+			if (auto const p = find_small_factor<block_t>(n, trial_division_prime_count(n.get_most_significant_bit() + 1u)); p != 0u)
+				return n == p;
 
-			utils::trim(result);
+			if (!n.get_bit(0u))
+				return false;
 
-			return result;
+			auto const rounds = miller_rabin<block_t>(n);
+
+			if (!rounds.test_base_2(ws))
+				return false;
+
+			return is_strong_lucas_probable_prime(rounds.context(), ws);
+		}
+
+#pragma region members - miller_rabin
+
+		template<class block_t>
+		miller_rabin<block_t>::miller_rabin(value_type const& n):
+			m_context(n),
+			m_m(n - 1u),
+			m_s(0u),
+			m_minus_one(n.get_allocator())
+		{
+			debug::die_if(n < 5u);
+
+			m_s = m_m.get_least_significant_bit();
+			m_m >>= m_s;
+
+			// -1 = n - R mod n, in montgomery form
+			m_minus_one = n - m_context.one();
 		}
 
 		template<class block_t>
-		math::big_uint<block_t> generate_prime(std::mt19937_64& rng, std::size_t num_bits)
+		typename miller_rabin<block_t>::value_type const& miller_rabin<block_t>::n() const
+		{
+			return m_context.modulus();
+		}
+
+		template<class block_t>
+		montgomery_context<block_t> const& miller_rabin<block_t>::context() const
+		{
+			return m_context;
+		}
+
+		template<class block_t>
+		bool miller_rabin<block_t>::test(value_type const& a, workspace<block_t>& ws) const
+		{
+			auto x = mod_pow(m_context, m_context.to_montgomery(a, ws), m_m, ws);
+			return test_squares(x, ws);
+		}
+
+		template<class block_t>
+		bool miller_rabin<block_t>::test_base_2(workspace<block_t>& ws) const
+		{
+			// left to right binary exponentiation, starting from 2^1 (m's top bit)
+			auto x = m_context.one();
+			double_mod(x);
+
+			for (auto i = m_m.get_most_significant_bit(); i != 0u; )
+			{
+				--i;
+
+				m_context.sqr_assign(x, ws);
+
+				if (m_m.get_bit(i))
+					double_mod(x);
+			}
+
+			return test_squares(x, ws);
+		}
+
+		template<class block_t>
+		bool miller_rabin<block_t>::test_squares(value_type& x, workspace<block_t>& ws) const
+		{
+			if (x == m_context.one() || x == m_minus_one)
+				return true;
+
+			for (auto i = std::size_t{ 1 }; i < m_s; ++i)
+			{
+				m_context.sqr_assign(x, ws);
+
+				if (x == m_minus_one)
+					return true;
+
+				// (1 without passing through -1: a non-trivial square root of 1)
+				if (x == m_context.one())
+					return false;
+			}
+
+			return false;
+		}
+
+		template<class block_t>
+		void miller_rabin<block_t>::double_mod(value_type& x) const
+		{
+			x <<= 1u;
+
+			if (x >= m_context.modulus())
+				x -= m_context.modulus();
+		}
+
+#pragma endregion
+
+		// the result (and the temporary numbers used to find it) are allocated with allocator.
+		template<class block_t>
+		math::big_uint<block_t> generate_prime(std::mt19937_64& rng, std::size_t num_bits, typename math::big_uint<block_t>::allocator_type const& allocator = { })
 		{
 			if (num_bits == 0u)
-				return{ };
+				return math::big_uint<block_t>(allocator);
 
 			while (true)
 			{
-				auto random_bits = generate_random_bits<block_t>(rng, num_bits);
+				auto random_bits = generate_random_bits<block_t>(rng, num_bits, allocator);
 
 				// set first (ensures odd number) and last (ensures large prime) num_bits
 				random_bits.set_bit(0u, true);
 				random_bits.set_bit(num_bits - 1u, true);
 
-				auto const two = math::big_uint<block_t>(2u);
+				auto const two = math::big_uint<block_t>(2u, allocator);
 
 				// search for prime number over an interval of 2*num_bits
 				auto const search_distance = std::size_t{ 2 } *num_bits;
@@ -208,39 +754,115 @@ namespace rsa
 			}
 
 			debug::die();
-			return{ };
+			return math::big_uint<block_t>(allocator);
 		}
 
+		// marks composite[i] if start + 2i has a factor in sieve_primes() less than start (so primes are never marked). start must be odd.
 		template<class block_t>
-		math::big_uint<block_t> generate_prime_rm(std::mt19937_64& rng, std::size_t num_bits, std::size_t k)
+		void sieve_candidates(std::pmr::vector<bool>& composite, math::big_uint<block_t> const& start)
 		{
-			if (num_bits == 0u)
-				return{ };
+			auto const mark = [&] (std::uint64_t p, std::uint64_t r)
+			{
+				// start + 2i = 0 (mod p), so i = -r / 2 = (p - r) * (p + 1) / 2 (mod p)
+				for (auto i = std::size_t(((p - r) % p) * ((p + 1u) / 2u) % p); i < composite.size(); i += std::size_t(p))
+					composite[i] = true;
+			};
 
-			while (true)
+			auto const& primes = sieve_primes();
+
+			for (auto j = std::size_t{ 0 }; j != primes.size(); )
 			{
-				auto random_bits = generate_random_bits<block_t>(rng, num_bits);
+				auto const p = primes[j];
 
-				// set first (ensures odd number) and last (ensures large prime) num_bits
-				random_bits.set_bit(0u, true);
-				random_bits.set_bit(num_bits - 1u, true);
+				// (start + 2i can only be p itself if start <= p)
+				if (start <= p)
+					break;
 
-				auto const two = math::big_uint<block_t>(2u);
+				// if a block can hold the product, one division gives the residues of two primes
+				if (utils::digits<block_t>() >= 32u && j + 1u != primes.size() && start > primes[j + 1u])
+				{
+					auto const q = primes[j + 1u];
+					auto const r = ops::mod(start, p * q);
+
+					mark(p, r % p);
+					mark(q, r % q);
+					j += 2u;
+				}
+				else
+				{
+					mark(p, ops::mod(start, p));
+					j += 1u;
+				}
+			}
+		}
+
+		namespace primes_detail
+		{
+
+			// searches for a prime of num_bits from a random odd start, over an interval of 2*num_bits, only testing the candidates
+			// the sieve doesn't rule out with is_prime(candidate). the result (and the temporary numbers used to find it) are
+			// allocated with allocator.
+			template<class block_t, class is_prime_t>
+			math::big_uint<block_t> generate_prime_sieved(std::mt19937_64& rng, std::size_t num_bits, typename math::big_uint<block_t>::allocator_type const& allocator, is_prime_t is_prime)
+			{
+				if (num_bits == 0u)
+					return math::big_uint<block_t>(allocator);
 
-				// search for prime number over an interval of 2*num_bits
 				auto const search_distance = 2u * num_bits;
+				auto composite = std::pmr::vector<bool>(allocator);
 
-				for (auto i = std::size_t{ 0 }; i != search_distance; ++i)
+				while (true)
 				{
-					if (math::is_prime_rm(random_bits, rng, k))
-						return random_bits;
+					auto random_bits = generate_random_bits<block_t>(rng, num_bits, allocator);
 
-					random_bits += two;
+					// set first (ensures odd number) and last (ensures large prime) num_bits
+					random_bits.set_bit(0u, true);
+					random_bits.set_bit(num_bits - 1u, true);
+
+					composite.assign(search_distance, false);
+					sieve_candidates(composite, random_bits);
+
+					auto offset = std::size_t{ 0 };
+
+					for (auto i = std::size_t{ 0 }; i != search_distance; ++i)
+					{
+						if (composite[i])
+							continue;
+
+						random_bits += 2u * (i - offset);
+						offset = i;
+
+						if (is_prime(random_bits))
+							return random_bits;
+					}
 				}
+
+				debug::die();
+				return math::big_uint<block_t>(allocator);
 			}
 
-			debug::die();
-			return{ };
+		} // primes_detail
+
+		// tests candidates with is_probable_prime_rm (k rounds, the first with base 2).
+		// the result (and the temporary numbers used to find it) are allocated with allocator.
+		template<class block_t>
+		math::big_uint<block_t> generate_prime_rm(std::mt19937_64& rng, std::size_t num_bits, std::size_t k, workspace<block_t>& ws = default_workspace<block_t>(), typename math::big_uint<block_t>::allocator_type const& allocator = { })
+		{
+			return primes_detail::generate_prime_sieved<block_t>(rng, num_bits, allocator,
+				[&] (math::big_uint<block_t> const& n)
+				{
+					// the sieve already ruled out every factor is_prime_rm would trial divide by. most candidates are composite,
+					// and rejected by the first round, so make it the cheaper base 2 round.
+					return math::is_probable_prime_rm(n, rng, k, ws, true);
+				});
+		}
+
+		// tests candidates with is_prime_bpsw. the result (and the temporary numbers used to find it) are allocated with allocator.
+		template<class block_t>
+		math::big_uint<block_t> generate_prime_bpsw(std::mt19937_64& rng, std::size_t num_bits, workspace<block_t>& ws = default_workspace<block_t>(), typename math::big_uint<block_t>::allocator_type const& allocator = { })
+		{
+			return primes_detail::generate_prime_sieved<block_t>(rng, num_bits, allocator,
+				[&] (math::big_uint<block_t> const& n) { return math::is_prime_bpsw(n, ws); });
 		}
 
 	} // math
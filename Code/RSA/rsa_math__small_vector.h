@@ -0,0 +1,702 @@
+#pragma once
+
+#include "rsa__debug.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace rsa
+{
+
+	namespace math
+	{
+
+		// a vector that stores up to inline_capacity elements inside the object itself, and only allocates when it grows larger.
+		// provides the subset of the std::vector interface used for big_uint data. elements must be trivially copyable.
+		// note: unlike std::vector, moving from a small_vector with inline storage copies the elements (and invalidates pointers to them).
+		// heap buffers are obtained from allocator_t, which follows the std::vector rules for propagation on copy / move / swap.
+		template<class value_t, std::size_t inline_capacity, class allocator_t = std::allocator<value_t>>
+		class small_vector
+		{
+		public:
+
+			static_assert(std::is_trivially_copyable_v<value_t>, "`value_t` must be trivially copyable.");
+			static_assert(inline_capacity != 0u, "`inline_capacity` must not be zero.");
+
+			using value_type = value_t;
+			using allocator_type = allocator_t;
+			using size_type = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using reference = value_t&;
+			using const_reference = value_t const&;
+			using pointer = value_t*;
+			using const_pointer = value_t const*;
+			using iterator = value_t*;
+			using const_iterator = value_t const*;
+			using reverse_iterator = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+#pragma region constructors
+
+			small_vector();
+			explicit small_vector(allocator_t const& allocator);
+			explicit small_vector(size_type count, allocator_t const& allocator = allocator_t());
+			small_vector(size_type count, value_t const& value, allocator_t const& allocator = allocator_t());
+
+			template<class inputit_t, typename = typename std::iterator_traits<inputit_t>::iterator_category>
+			small_vector(inputit_t first, inputit_t last, allocator_t const& allocator = allocator_t());
+
+			small_vector(std::initializer_list<value_t> values, allocator_t const& allocator = allocator_t());
+
+			small_vector(small_vector const& other);
+			small_vector(small_vector const& other, allocator_t const& allocator);
+			small_vector(small_vector&& other) noexcept;
+			small_vector(small_vector&& other, allocator_t const& allocator);
+
+			~small_vector();
+
+#pragma endregion
+
+#pragma region assignment
+
+			small_vector& operator=(small_vector const& other);
+			small_vector& operator=(small_vector&& other) noexcept(std::allocator_traits<allocator_t>::propagate_on_container_move_assignment::value || std::allocator_traits<allocator_t>::is_always_equal::value);
+			small_vector& operator=(std::initializer_list<value_t> values);
+
+			void assign(size_type count, value_t const& value);
+
+			template<class inputit_t, typename = typename std::iterator_traits<inputit_t>::iterator_category>
+			void assign(inputit_t first, inputit_t last);
+
+#pragma endregion
+
+#pragma region element access
+
+			reference operator[](size_type i);
+			const_reference operator[](size_type i) const;
+
+			reference front();
+			const_reference front() const;
+
+			reference back();
+			const_reference back() const;
+
+			pointer data();
+			const_pointer data() const;
+
+			allocator_t get_allocator() const;
+
+#pragma endregion
+
+#pragma region iterators
+
+			iterator begin();
+			const_iterator begin() const;
+			const_iterator cbegin() const;
+
+			iterator end();
+			const_iterator end() const;
+			const_iterator cend() const;
+
+			reverse_iterator rbegin();
+			const_reverse_iterator rbegin() const;
+
+			reverse_iterator rend();
+			const_reverse_iterator rend() const;
+
+#pragma endregion
+
+#pragma region capacity
+
+			bool empty() const;
+			size_type size() const;
+			size_type capacity() const;
+
+			void reserve(size_type new_capacity);
+
+			// whether the elements are stored inside the object (i.e. nothing has been allocated).
+			bool is_inline() const;
+
+#pragma endregion
+
+#pragma region modifiers
+
+			void clear();
+
+			iterator insert(const_iterator pos, value_t const& value);
+			iterator insert(const_iterator pos, size_type count, value_t const& value);
+
+			template<class inputit_t, typename = typename std::iterator_traits<inputit_t>::iterator_category>
+			iterator insert(const_iterator pos, inputit_t first, inputit_t last);
+
+			iterator erase(const_iterator pos);
+			iterator erase(const_iterator first, const_iterator last);
+
+			void push_back(value_t const& value);
+			void pop_back();
+
+			void resize(size_type count);
+			void resize(size_type count, value_t const& value);
+
+			void swap(small_vector& other) noexcept;
+
+#pragma endregion
+
+		private:
+
+			// makes space for count elements at index, moving the elements after it up. returns a pointer to the space.
+			value_t* open_gap(size_type index, size_type count);
+
+			// moves the elements to a new buffer of at least min_capacity (leaving space for count elements at index).
+			void reallocate(size_type min_capacity, size_type index = 0u, size_type count = 0u);
+
+			void deallocate();
+
+			// exchanges the elements (but not the allocators).
+			void swap_storage(small_vector& other) noexcept;
+
+			using allocator_traits = std::allocator_traits<allocator_t>;
+
+			allocator_t m_allocator;
+			value_t* m_data;
+			size_type m_size;
+			size_type m_capacity;
+			value_t m_inline[inline_capacity];
+		};
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		bool operator==(small_vector<value_t, inline_capacity, allocator_t> const& a, small_vector<value_t, inline_capacity, allocator_t> const& b)
+		{
+			return std::equal(a.begin(), a.end(), b.begin(), b.end());
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		bool operator!=(small_vector<value_t, inline_capacity, allocator_t> const& a, small_vector<value_t, inline_capacity, allocator_t> const& b)
+		{
+			return !(a == b);
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		bool operator<(small_vector<value_t, inline_capacity, allocator_t> const& a, small_vector<value_t, inline_capacity, allocator_t> const& b)
+		{
+			return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+		}
+
+#pragma region members - constructors
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		small_vector<value_t, inline_capacity, allocator_t>::small_vector():
+			small_vector(allocator_t())
+		{
+
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		small_vector<value_t, inline_capacity, allocator_t>::small_vector(allocator_t const& allocator):
+			m_allocator(allocator),
+			m_data(m_inline),
+			m_size(0u),
+			m_capacity(inline_capacity)
+		{
+
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		small_vector<value_t, inline_capacity, allocator_t>::small_vector(size_type count, allocator_t const& allocator):
+			small_vector(count, value_t{ }, allocator)
+		{
+
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		small_vector<value_t, inline_capacity, allocator_t>::small_vector(size_type count, value_t const& value, allocator_t const& allocator):
+			small_vector(allocator)
+		{
+			assign(count, value);
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		template<class inputit_t, typename>
+		small_vector<value_t, inline_capacity, allocator_t>::small_vector(inputit_t first, inputit_t last, allocator_t const& allocator):
+			small_vector(allocator)
+		{
+			assign(first, last);
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		small_vector<value_t, inline_capacity, allocator_t>::small_vector(std::initializer_list<value_t> values, allocator_t const& allocator):
+			small_vector(allocator)
+		{
+			assign(values.begin(), values.end());
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		small_vector<value_t, inline_capacity, allocator_t>::small_vector(small_vector const& other):
+			small_vector(other, allocator_traits::select_on_container_copy_construction(other.m_allocator))
+		{
+
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		small_vector<value_t, inline_capacity, allocator_t>::small_vector(small_vector const& other, allocator_t const& allocator):
+			small_vector(allocator)
+		{
+			assign(other.begin(), other.end());
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		small_vector<value_t, inline_capacity, allocator_t>::small_vector(small_vector&& other) noexcept:
+			small_vector(other.m_allocator)
+		{
+			swap_storage(other);
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		small_vector<value_t, inline_capacity, allocator_t>::small_vector(small_vector&& other, allocator_t const& allocator):
+			small_vector(allocator)
+		{
+			if (m_allocator == other.m_allocator)
+				swap_storage(other);
+			else
+				assign(other.begin(), other.end());
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		small_vector<value_t, inline_capacity, allocator_t>::~small_vector()
+		{
+			deallocate();
+		}
+
+#pragma endregion
+
+#pragma region members - assignment
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		small_vector<value_t, inline_capacity, allocator_t>& small_vector<value_t, inline_capacity, allocator_t>::operator=(small_vector const& other)
+		{
+			if (&other == this)
+				return *this;
+
+			if constexpr (allocator_traits::propagate_on_container_copy_assignment::value)
+			{
+				if (m_allocator != other.m_allocator)
+				{
+					// (the current buffer must be freed with the current allocator)
+					clear();
+					deallocate();
+					m_capacity = inline_capacity;
+				}
+
+				m_allocator = other.m_allocator;
+			}
+
+			assign(other.begin(), other.end());
+
+			return *this;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		small_vector<value_t, inline_capacity, allocator_t>& small_vector<value_t, inline_capacity, allocator_t>::operator=(small_vector&& other) noexcept(std::allocator_traits<allocator_t>::propagate_on_container_move_assignment::value || std::allocator_traits<allocator_t>::is_always_equal::value)
+		{
+			if (&other == this)
+				return *this;
+
+			clear();
+
+			if constexpr (allocator_traits::propagate_on_container_move_assignment::value)
+			{
+				deallocate();
+				m_capacity = inline_capacity;
+				m_allocator = other.m_allocator;
+			}
+
+			// (buffers can only change owner if both vectors use the same allocator)
+			if (m_allocator == other.m_allocator)
+				swap_storage(other);
+			else
+				assign(other.begin(), other.end());
+
+			return *this;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		small_vector<value_t, inline_capacity, allocator_t>& small_vector<value_t, inline_capacity, allocator_t>::operator=(std::initializer_list<value_t> values)
+		{
+			assign(values.begin(), values.end());
+			return *this;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		void small_vector<value_t, inline_capacity, allocator_t>::assign(size_type count, value_t const& value)
+		{
+			if (count > m_capacity)
+				reallocate(count);
+
+			std::fill(m_data, m_data + count, value);
+			m_size = count;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		template<class inputit_t, typename>
+		void small_vector<value_t, inline_capacity, allocator_t>::assign(inputit_t first, inputit_t last)
+		{
+			auto const count = static_cast<size_type>(std::distance(first, last));
+
+			// (the existing elements aren't needed, so needn't be copied)
+			if (count > m_capacity)
+			{
+				m_size = 0u;
+				reallocate(count);
+			}
+
+			std::copy(first, last, m_data);
+			m_size = count;
+		}
+
+#pragma endregion
+
+#pragma region members - element access
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::reference small_vector<value_t, inline_capacity, allocator_t>::operator[](size_type i)
+		{
+			return m_data[i];
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::const_reference small_vector<value_t, inline_capacity, allocator_t>::operator[](size_type i) const
+		{
+			return m_data[i];
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::reference small_vector<value_t, inline_capacity, allocator_t>::front()
+		{
+			return m_data[0];
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::const_reference small_vector<value_t, inline_capacity, allocator_t>::front() const
+		{
+			return m_data[0];
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::reference small_vector<value_t, inline_capacity, allocator_t>::back()
+		{
+			return m_data[m_size - 1u];
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::const_reference small_vector<value_t, inline_capacity, allocator_t>::back() const
+		{
+			return m_data[m_size - 1u];
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::pointer small_vector<value_t, inline_capacity, allocator_t>::data()
+		{
+			return m_data;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::const_pointer small_vector<value_t, inline_capacity, allocator_t>::data() const
+		{
+			return m_data;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		allocator_t small_vector<value_t, inline_capacity, allocator_t>::get_allocator() const
+		{
+			return m_allocator;
+		}
+
+#pragma endregion
+
+#pragma region members - iterators
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::iterator small_vector<value_t, inline_capacity, allocator_t>::begin()
+		{
+			return m_data;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::const_iterator small_vector<value_t, inline_capacity, allocator_t>::begin() const
+		{
+			return m_data;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::const_iterator small_vector<value_t, inline_capacity, allocator_t>::cbegin() const
+		{
+			return m_data;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::iterator small_vector<value_t, inline_capacity, allocator_t>::end()
+		{
+			return m_data + m_size;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::const_iterator small_vector<value_t, inline_capacity, allocator_t>::end() const
+		{
+			return m_data + m_size;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::const_iterator small_vector<value_t, inline_capacity, allocator_t>::cend() const
+		{
+			return m_data + m_size;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::reverse_iterator small_vector<value_t, inline_capacity, allocator_t>::rbegin()
+		{
+			return reverse_iterator(end());
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::const_reverse_iterator small_vector<value_t, inline_capacity, allocator_t>::rbegin() const
+		{
+			return const_reverse_iterator(end());
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::reverse_iterator small_vector<value_t, inline_capacity, allocator_t>::rend()
+		{
+			return reverse_iterator(begin());
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::const_reverse_iterator small_vector<value_t, inline_capacity, allocator_t>::rend() const
+		{
+			return const_reverse_iterator(begin());
+		}
+
+#pragma endregion
+
+#pragma region members - capacity
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		bool small_vector<value_t, inline_capacity, allocator_t>::empty() const
+		{
+			return (m_size == 0u);
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::size_type small_vector<value_t, inline_capacity, allocator_t>::size() const
+		{
+			return m_size;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::size_type small_vector<value_t, inline_capacity, allocator_t>::capacity() const
+		{
+			return m_capacity;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		void small_vector<value_t, inline_capacity, allocator_t>::reserve(size_type new_capacity)
+		{
+			if (new_capacity > m_capacity)
+				reallocate(new_capacity);
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		bool small_vector<value_t, inline_capacity, allocator_t>::is_inline() const
+		{
+			return (m_data == m_inline);
+		}
+
+#pragma endregion
+
+#pragma region members - modifiers
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		void small_vector<value_t, inline_capacity, allocator_t>::clear()
+		{
+			m_size = 0u;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::iterator small_vector<value_t, inline_capacity, allocator_t>::insert(const_iterator pos, value_t const& value)
+		{
+			return insert(pos, size_type{ 1 }, value);
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::iterator small_vector<value_t, inline_capacity, allocator_t>::insert(const_iterator pos, size_type count, value_t const& value)
+		{
+			auto const fill = value; // (value may be an element of this vector)
+			auto const gap = open_gap(static_cast<size_type>(pos - m_data), count);
+
+			std::fill(gap, gap + count, fill);
+
+			return gap;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		template<class inputit_t, typename>
+		typename small_vector<value_t, inline_capacity, allocator_t>::iterator small_vector<value_t, inline_capacity, allocator_t>::insert(const_iterator pos, inputit_t first, inputit_t last)
+		{
+			auto const count = static_cast<size_type>(std::distance(first, last));
+			auto const gap = open_gap(static_cast<size_type>(pos - m_data), count);
+
+			std::copy(first, last, gap);
+
+			return gap;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::iterator small_vector<value_t, inline_capacity, allocator_t>::erase(const_iterator pos)
+		{
+			return erase(pos, pos + 1);
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		typename small_vector<value_t, inline_capacity, allocator_t>::iterator small_vector<value_t, inline_capacity, allocator_t>::erase(const_iterator first, const_iterator last)
+		{
+			auto const index = static_cast<size_type>(first - m_data);
+			auto const count = static_cast<size_type>(last - first);
+
+			std::copy(m_data + index + count, m_data + m_size, m_data + index);
+			m_size -= count;
+
+			return m_data + index;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		void small_vector<value_t, inline_capacity, allocator_t>::push_back(value_t const& value)
+		{
+			if (m_size == m_capacity)
+			{
+				auto const copy = value; // (value may be an element of this vector)
+				reallocate(m_size + 1u);
+				m_data[m_size++] = copy;
+				return;
+			}
+
+			m_data[m_size++] = value;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		void small_vector<value_t, inline_capacity, allocator_t>::pop_back()
+		{
+			debug::die_if(m_size == 0u);
+			--m_size;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		void small_vector<value_t, inline_capacity, allocator_t>::resize(size_type count)
+		{
+			resize(count, value_t{ });
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		void small_vector<value_t, inline_capacity, allocator_t>::resize(size_type count, value_t const& value)
+		{
+			if (count > m_size)
+			{
+				auto const fill = value; // (value may be an element of this vector)
+
+				if (count > m_capacity)
+					reallocate(count);
+
+				std::fill(m_data + m_size, m_data + count, fill);
+			}
+
+			m_size = count;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		void small_vector<value_t, inline_capacity, allocator_t>::swap(small_vector& other) noexcept
+		{
+			if constexpr (allocator_traits::propagate_on_container_swap::value)
+				std::swap(m_allocator, other.m_allocator);
+			else
+				debug::die_if(m_allocator != other.m_allocator); // (as for std::vector, the allocators must be equal)
+
+			swap_storage(other);
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		void small_vector<value_t, inline_capacity, allocator_t>::swap_storage(small_vector& other) noexcept
+		{
+			if (!is_inline() && !other.is_inline())
+			{
+				std::swap(m_data, other.m_data);
+			}
+			else if (is_inline() && other.is_inline())
+			{
+				value_t temp[inline_capacity];
+				std::copy(m_inline, m_inline + m_size, temp);
+				std::copy(other.m_inline, other.m_inline + other.m_size, m_inline);
+				std::copy(temp, temp + m_size, other.m_inline);
+			}
+			else
+			{
+				// one heap buffer changes owner, and the inline elements are copied the other way
+				auto& inline_vector = is_inline() ? *this : other;
+				auto& heap_vector = is_inline() ? other : *this;
+
+				std::copy(inline_vector.m_inline, inline_vector.m_inline + inline_vector.m_size, heap_vector.m_inline);
+
+				inline_vector.m_data = heap_vector.m_data;
+				heap_vector.m_data = heap_vector.m_inline;
+			}
+
+			std::swap(m_size, other.m_size);
+			std::swap(m_capacity, other.m_capacity);
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		value_t* small_vector<value_t, inline_capacity, allocator_t>::open_gap(size_type index, size_type count)
+		{
+			debug::die_if(index > m_size);
+
+			if (m_size + count > m_capacity)
+				reallocate(m_size + count, index, count);
+			else
+				std::copy_backward(m_data + index, m_data + m_size, m_data + m_size + count);
+
+			m_size += count;
+
+			return m_data + index;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		void small_vector<value_t, inline_capacity, allocator_t>::reallocate(size_type min_capacity, size_type index, size_type count)
+		{
+			auto const new_capacity = std::max(min_capacity, 2u * m_capacity);
+			auto const new_data = allocator_traits::allocate(m_allocator, new_capacity);
+
+			// (index and count leave a gap in the new buffer)
+			std::copy(m_data, m_data + index, new_data);
+			std::copy(m_data + index, m_data + m_size, new_data + index + count);
+
+			deallocate();
+
+			m_data = new_data;
+			m_capacity = new_capacity;
+		}
+
+		template<class value_t, std::size_t inline_capacity, class allocator_t>
+		void small_vector<value_t, inline_capacity, allocator_t>::deallocate()
+		{
+			if (!is_inline())
+				allocator_traits::deallocate(m_allocator, m_data, m_capacity);
+
+			m_data = m_inline;
+		}
+
+#pragma endregion
+
+	} // math
+
+} // rsa
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <type_traits>
@@ -14,15 +16,53 @@ namespace rsa
 		template<class block_t>
 		class big_uint;
 
+		template<class block_t>
+		struct block_traits;
+
+		template<>
+		struct block_traits<std::uint8_t> { using double_block_type = std::uint16_t; };
+
+		template<>
+		struct block_traits<std::uint16_t> { using double_block_type = std::uint32_t; };
+
+		template<>
+		struct block_traits<std::uint32_t> { using double_block_type = std::uint64_t; };
+
+#if defined(__SIZEOF_INT128__)
+
+		// note: there's no standard 128 bit integer, so 64 bit blocks are only available where the compiler provides one.
+		template<>
+		struct block_traits<std::uint64_t> { using double_block_type = unsigned __int128; };
+
+#endif
+
 		namespace utils
 		{
 
 			template<class uint_t>
-			constexpr bool is_uint_v = (std::is_integral_v<uint_t> && std::is_unsigned_v<uint_t> && !std::is_same_v<uint_t, bool>);
+			struct is_uint : std::integral_constant<bool, (std::is_integral_v<uint_t> && std::is_unsigned_v<uint_t> && !std::is_same_v<uint_t, bool>)> { };
+
+#if defined(__SIZEOF_INT128__)
+
+			// (not an integral type in strict standard modes)
+			template<>
+			struct is_uint<unsigned __int128> : std::true_type { };
+
+#endif
+
+			template<class uint_t>
+			constexpr bool is_uint_v = is_uint<uint_t>::value;
 
 			template<class uint_t>
 			using enable_if_uint_t = std::enable_if_t<is_uint_v<uint_t>>;
 
+			// a parameter of type identity_t<t> isn't used for template argument deduction, so arguments may be implicitly converted to t.
+			template<class t>
+			struct identity { using type = t; };
+
+			template<class t>
+			using identity_t = typename identity<t>::type;
+
 
 			template<class t>
 			constexpr std::uint32_t digits()
@@ -36,6 +76,58 @@ namespace rsa
 				return std::numeric_limits<t>::max();
 			}
 
+#if defined(__SIZEOF_INT128__)
+
+			// std::numeric_limits isn't necessarily specialized for 128 bit integers.
+
+			template<>
+			constexpr std::uint32_t digits<unsigned __int128>()
+			{
+				return 128u;
+			}
+
+			template<>
+			constexpr unsigned __int128 max<unsigned __int128>()
+			{
+				return ~static_cast<unsigned __int128>(0u);
+			}
+
+#endif
+
+			// the blocks of an unsigned integer (least significant first, without high zero blocks), stored in place.
+			// allows integers to be used as operands without allocating a big_uint.
+			template<class block_t, class uint_t>
+			struct uint_blocks
+			{
+				static constexpr std::size_t capacity = (digits<uint_t>() + digits<block_t>() - 1u) / digits<block_t>();
+
+				std::array<block_t, capacity> blocks;
+				std::size_t size;
+			};
+
+			template<class block_t, class uint_t>
+			uint_blocks<block_t, uint_t> to_blocks(uint_t n)
+			{
+				static_assert(is_uint_v<uint_t>, "`uint_t` must be an unsigned integer.");
+
+				// shifting by >= the number digits in the type is undefined behaviour.
+				constexpr bool can_rshift = (digits<block_t>() < digits<uint_t>());
+
+				auto result = uint_blocks<block_t, uint_t>{ };
+
+				while (n != uint_t{ 0 })
+				{
+					result.blocks[result.size++] = static_cast<block_t>(max<block_t>() & n);
+
+					if constexpr (can_rshift)
+						n >>= digits<block_t>();
+					else
+						n = uint_t{ 0 };
+				}
+
+				return result;
+			}
+
 
 			template<class block_t>
 			bool has_extra_empty_blocks(big_uint<block_t> const& a)
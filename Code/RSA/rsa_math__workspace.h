@@ -0,0 +1,172 @@
+#pragma once
+
+#include "rsa__debug.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace rsa
+{
+
+	namespace math
+	{
+
+		// scratch space (in blocks) for the arithmetic functions, so temporary buffers don't need allocating for every operation.
+		// buffers are taken from a few large chunks of memory and released in reverse order. once a workspace has grown large
+		// enough for a calculation, repeating the calculation doesn't allocate.
+		template<class block_t>
+		class workspace
+		{
+		public:
+
+			// buffers allocated from a frame are released when it is destroyed. frames must be destroyed in
+			// reverse order of construction (i.e. used as local variables).
+			class frame
+			{
+			public:
+
+				explicit frame(workspace& ws);
+				~frame();
+
+				frame(frame const&) = delete;
+				frame& operator=(frame const&) = delete;
+
+				// returns n blocks of zeroed memory.
+				block_t* allocate(std::size_t n);
+
+			private:
+
+				workspace& m_workspace;
+				std::size_t m_chunk;
+				std::size_t m_used;
+			};
+
+#pragma region constructors
+
+			workspace() = default;
+
+			workspace(workspace const&) = delete;
+			workspace(workspace&&) = default;
+
+#pragma endregion
+
+#pragma region assignment
+
+			workspace& operator=(workspace const&) = delete;
+			workspace& operator=(workspace&&) = default;
+
+#pragma endregion
+
+#pragma region general
+
+			// the total number of blocks (in use or not).
+			std::size_t capacity() const;
+
+#pragma endregion
+
+		private:
+
+			block_t* allocate(std::size_t n);
+
+			std::vector<std::vector<block_t>> m_chunks;
+			std::size_t m_chunk = 0; // the chunk currently being allocated from
+			std::size_t m_used = 0; // blocks in use in the current chunk
+			std::size_t m_frames = 0;
+		};
+
+		// the workspace used by functions that aren't given one (one per thread, per block type).
+		template<class block_t>
+		workspace<block_t>& default_workspace()
+		{
+			thread_local workspace<block_t> ws;
+			return ws;
+		}
+
+#pragma region members - frame
+
+		template<class block_t>
+		workspace<block_t>::frame::frame(workspace& ws):
+			m_workspace(ws),
+			m_chunk(ws.m_chunk),
+			m_used(ws.m_used)
+		{
+			++m_workspace.m_frames;
+		}
+
+		template<class block_t>
+		workspace<block_t>::frame::~frame()
+		{
+			auto& ws = m_workspace;
+
+			ws.m_chunk = m_chunk;
+			ws.m_used = m_used;
+
+			// once everything is released, merge the chunks (so next time one chunk is enough)
+			if (--ws.m_frames == 0u && ws.m_chunks.size() > 1u)
+			{
+				auto const total = ws.capacity();
+
+				ws.m_chunks.clear();
+				ws.m_chunks.emplace_back(total);
+				ws.m_chunk = 0u;
+				ws.m_used = 0u;
+			}
+		}
+
+		template<class block_t>
+		block_t* workspace<block_t>::frame::allocate(std::size_t n)
+		{
+			return m_workspace.allocate(n);
+		}
+
+#pragma endregion
+
+#pragma region members - general
+
+		template<class block_t>
+		std::size_t workspace<block_t>::capacity() const
+		{
+			auto result = std::size_t{ 0 };
+
+			for (auto const& c : m_chunks)
+				result += c.size();
+
+			return result;
+		}
+
+		template<class block_t>
+		block_t* workspace<block_t>::allocate(std::size_t n)
+		{
+			debug::die_if(m_frames == 0u);
+
+			if (m_chunk == m_chunks.size() || m_chunks[m_chunk].size() - m_used < n)
+			{
+				// the current chunk is full, use the next one (chunks after the current one are never in use)
+				if (m_chunk != m_chunks.size())
+				{
+					++m_chunk;
+					m_used = 0u;
+				}
+
+				auto const size = std::max({ n, capacity(), std::size_t{ 256 } });
+
+				if (m_chunk == m_chunks.size())
+					m_chunks.emplace_back(size);
+				else if (m_chunks[m_chunk].size() < n)
+					m_chunks[m_chunk].assign(size, block_t{ 0 });
+			}
+
+			auto const result = m_chunks[m_chunk].data() + m_used;
+			m_used += n;
+
+			std::fill(result, result + n, block_t{ 0 });
+
+			return result;
+		}
+
+#pragma endregion
+
+	} // math
+
+} // rsa
@@ -0,0 +1,324 @@
+#pragma once
+
+#include "rsa__debug.h"
+#include "rsa_math__utils.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rsa
+{
+
+	namespace math
+	{
+
+		namespace ops
+		{
+
+			// low level kernels operating directly on ranges of blocks (least significant block first).
+			// these don't allocate, trim, or check for zero. output ranges must already be the correct size.
+			namespace blocks
+			{
+
+				// r[0, n) = a[0, n) + b[0, n), returns the carry. r may be the same as a or b.
+				template<class block_t>
+				block_t add_n(block_t* r, block_t const* a, block_t const* b, std::size_t n)
+				{
+					using double_block_t = typename block_traits<block_t>::double_block_type;
+
+					auto carry = double_block_t{ 0 };
+
+					for (auto i = std::size_t{ 0 }; i != n; ++i)
+					{
+						carry += static_cast<double_block_t>(a[i]) + static_cast<double_block_t>(b[i]);
+						r[i] = static_cast<block_t>(carry);
+						carry >>= utils::digits<block_t>();
+					}
+
+					return static_cast<block_t>(carry);
+				}
+
+				// r[0, an) = a[0, an) + b[0, bn), returns the carry. requires an >= bn. r may be the same as a.
+				template<class block_t>
+				block_t add(block_t* r, block_t const* a, std::size_t an, block_t const* b, std::size_t bn)
+				{
+					using double_block_t = typename block_traits<block_t>::double_block_type;
+
+					debug::die_if(an < bn);
+
+					auto carry = double_block_t{ add_n(r, a, b, bn) };
+
+					for (auto i = bn; i != an; ++i)
+					{
+						carry += static_cast<double_block_t>(a[i]);
+						r[i] = static_cast<block_t>(carry);
+						carry >>= utils::digits<block_t>();
+					}
+
+					return static_cast<block_t>(carry);
+				}
+
+				// r[0, n) = a[0, n) + b, returns the carry. r may be the same as a.
+				template<class block_t>
+				block_t add_1(block_t* r, block_t const* a, std::size_t n, block_t b)
+				{
+					auto carry = b;
+					auto i = std::size_t{ 0 };
+
+					for (; i != n && carry != block_t{ 0 }; ++i)
+					{
+						r[i] = block_t(a[i] + carry);
+						carry = block_t(r[i] < carry ? 1u : 0u);
+					}
+
+					if (r != a)
+						for (; i != n; ++i)
+							r[i] = a[i];
+
+					return carry;
+				}
+
+				// r[0, n) = a[0, n) - b, returns the borrow. r may be the same as a.
+				template<class block_t>
+				block_t sub_1(block_t* r, block_t const* a, std::size_t n, block_t b)
+				{
+					auto borrow = b;
+					auto i = std::size_t{ 0 };
+
+					for (; i != n && borrow != block_t{ 0 }; ++i)
+					{
+						auto const x = a[i];
+						r[i] = block_t(x - borrow);
+						borrow = block_t(x < borrow ? 1u : 0u);
+					}
+
+					if (r != a)
+						for (; i != n; ++i)
+							r[i] = a[i];
+
+					return borrow;
+				}
+
+				// r[0, n) = a[0, n) - b[0, n), returns the borrow. r may be the same as a or b.
+				template<class block_t>
+				block_t sub_n(block_t* r, block_t const* a, block_t const* b, std::size_t n)
+				{
+					using double_block_t = typename block_traits<block_t>::double_block_type;
+
+					auto borrow = double_block_t{ 0 };
+
+					for (auto i = std::size_t{ 0 }; i != n; ++i)
+					{
+						borrow = static_cast<double_block_t>(a[i]) - static_cast<double_block_t>(b[i]) - borrow;
+						r[i] = static_cast<block_t>(borrow);
+						borrow = (borrow >> utils::digits<block_t>()) & double_block_t{ 1 };
+					}
+
+					return static_cast<block_t>(borrow);
+				}
+
+				// r[0, an) = a[0, an) - b[0, bn), returns the borrow. requires an >= bn. r may be the same as a.
+				template<class block_t>
+				block_t sub(block_t* r, block_t const* a, std::size_t an, block_t const* b, std::size_t bn)
+				{
+					using double_block_t = typename block_traits<block_t>::double_block_type;
+
+					debug::die_if(an < bn);
+
+					auto borrow = double_block_t{ sub_n(r, a, b, bn) };
+
+					for (auto i = bn; i != an; ++i)
+					{
+						borrow = static_cast<double_block_t>(a[i]) - borrow;
+						r[i] = static_cast<block_t>(borrow);
+						borrow = (borrow >> utils::digits<block_t>()) & double_block_t{ 1 };
+					}
+
+					return static_cast<block_t>(borrow);
+				}
+
+				// r[0, n) = a[0, n) * b, returns the high block.
+				template<class block_t>
+				block_t mul_1(block_t* r, block_t const* a, std::size_t n, block_t b)
+				{
+					using double_block_t = typename block_traits<block_t>::double_block_type;
+
+					auto carry = double_block_t{ 0 };
+
+					for (auto i = std::size_t{ 0 }; i != n; ++i)
+					{
+						carry += static_cast<double_block_t>(a[i]) * static_cast<double_block_t>(b);
+						r[i] = static_cast<block_t>(carry);
+						carry >>= utils::digits<block_t>();
+					}
+
+					return static_cast<block_t>(carry);
+				}
+
+				// r[0, n) += a[0, n) * b, returns the high block.
+				template<class block_t>
+				block_t addmul_1(block_t* r, block_t const* a, std::size_t n, block_t b)
+				{
+					using double_block_t = typename block_traits<block_t>::double_block_type;
+
+					// note: relies on double_block_t holding (max<block_t>() * max<block_t>() + 2 * max<block_t>())
+					auto carry = double_block_t{ 0 };
+
+					for (auto i = std::size_t{ 0 }; i != n; ++i)
+					{
+						carry += static_cast<double_block_t>(a[i]) * static_cast<double_block_t>(b);
+						carry += r[i];
+						r[i] = static_cast<block_t>(carry);
+						carry >>= utils::digits<block_t>();
+					}
+
+					return static_cast<block_t>(carry);
+				}
+
+				// r[0, n) -= a[0, n) * b, returns the borrow.
+				template<class block_t>
+				block_t submul_1(block_t* r, block_t const* a, std::size_t n, block_t b)
+				{
+					using double_block_t = typename block_traits<block_t>::double_block_type;
+
+					auto carry = double_block_t{ 0 };
+
+					for (auto i = std::size_t{ 0 }; i != n; ++i)
+					{
+						carry += static_cast<double_block_t>(a[i]) * static_cast<double_block_t>(b);
+
+						auto const low = static_cast<block_t>(carry);
+						carry >>= utils::digits<block_t>();
+
+						if (r[i] < low)
+							++carry;
+
+						r[i] = block_t(r[i] - low);
+					}
+
+					return static_cast<block_t>(carry);
+				}
+
+				// r[0, n) = a[0, n) & b[0, n). r may be the same as a or b.
+				template<class block_t>
+				void and_n(block_t* r, block_t const* a, block_t const* b, std::size_t n)
+				{
+					for (auto i = std::size_t{ 0 }; i != n; ++i)
+						r[i] = block_t(a[i] & b[i]);
+				}
+
+				// r[0, n) = a[0, n) | b[0, n). r may be the same as a or b.
+				template<class block_t>
+				void ior_n(block_t* r, block_t const* a, block_t const* b, std::size_t n)
+				{
+					for (auto i = std::size_t{ 0 }; i != n; ++i)
+						r[i] = block_t(a[i] | b[i]);
+				}
+
+				// r[0, n) = a[0, n) ^ b[0, n). r may be the same as a or b.
+				template<class block_t>
+				void xor_n(block_t* r, block_t const* a, block_t const* b, std::size_t n)
+				{
+					for (auto i = std::size_t{ 0 }; i != n; ++i)
+						r[i] = block_t(a[i] ^ b[i]);
+				}
+
+				// the number of blocks in a[0, n) after removing high zero blocks.
+				template<class block_t>
+				std::size_t normalized_size(block_t const* a, std::size_t n)
+				{
+					while (n != 0u && a[n - 1u] == block_t{ 0 })
+						--n;
+
+					return n;
+				}
+
+				// compares a[0, an) with b[0, bn) (high zero blocks are ignored). returns -1, 0 or 1.
+				template<class block_t>
+				int cmp(block_t const* a, std::size_t an, block_t const* b, std::size_t bn)
+				{
+					an = normalized_size(a, an);
+					bn = normalized_size(b, bn);
+
+					if (an != bn)
+						return (an < bn) ? -1 : 1;
+
+					for (auto i = an; i != 0u; --i)
+						if (a[i - 1u] != b[i - 1u])
+							return (a[i - 1u] < b[i - 1u]) ? -1 : 1;
+
+					return 0;
+				}
+
+				// r[0, n) = a[0, n) << shift, returns the bits shifted out. requires 0 < shift < digits.
+				// r may be the same as a, or overlap it from above (the blocks are written from the top down).
+				template<class block_t>
+				block_t lshift(block_t* r, block_t const* a, std::size_t n, std::uint32_t shift)
+				{
+					debug::die_if(shift == 0u || shift >= utils::digits<block_t>());
+
+					if (n == 0u)
+						return block_t{ 0 };
+
+					auto const carry_shift = utils::digits<block_t>() - shift;
+					auto const carry_out = block_t(a[n - 1u] >> carry_shift);
+
+					for (auto i = n - 1u; i != 0u; --i)
+						r[i] = block_t(a[i] << shift) | block_t(a[i - 1u] >> carry_shift);
+
+					r[0] = block_t(a[0] << shift);
+
+					return carry_out;
+				}
+
+				// r[0, n) = a[0, n) >> shift, returns the bits shifted out (in the high bits). requires 0 < shift < digits.
+				// r may be the same as a, or overlap it from below (the blocks are written from the bottom up).
+				template<class block_t>
+				block_t rshift(block_t* r, block_t const* a, std::size_t n, std::uint32_t shift)
+				{
+					debug::die_if(shift == 0u || shift >= utils::digits<block_t>());
+
+					if (n == 0u)
+						return block_t{ 0 };
+
+					auto const carry_shift = utils::digits<block_t>() - shift;
+					auto const carry_out = block_t(a[0] << carry_shift);
+
+					for (auto i = std::size_t{ 0 }; i != n - 1u; ++i)
+						r[i] = block_t(a[i] >> shift) | block_t(a[i + 1u] << carry_shift);
+
+					r[n - 1u] = block_t(a[n - 1u] >> shift);
+
+					return carry_out;
+				}
+
+				// r[0, n) = a[0, n) / 3, where a is known to be a multiple of 3. r may be the same as a.
+				template<class block_t>
+				void divexact_by3(block_t* r, block_t const* a, std::size_t n)
+				{
+					using double_block_t = typename block_traits<block_t>::double_block_type;
+
+					// 3 * inverse == 1 (mod B), so multiplying by the inverse divides exactly (jebelean's method)
+					auto const inverse = block_t(utils::max<block_t>() / 3u * 2u + 1u);
+					auto carry = block_t{ 0 };
+
+					for (auto i = std::size_t{ 0 }; i != n; ++i)
+					{
+						auto const x = block_t(a[i] - carry);
+						auto const borrow = block_t(x > a[i] ? 1u : 0u);
+						auto const q = static_cast<block_t>(static_cast<double_block_t>(x) * inverse);
+
+						r[i] = q;
+						carry = block_t((static_cast<double_block_t>(q) * 3u) >> utils::digits<block_t>()) + borrow;
+					}
+
+					debug::die_if(carry != 0u);
+				}
+
+			} // blocks
+
+		} // ops
+
+	} // math
+
+} // rsa
@@ -0,0 +1,326 @@
+#pragma once
+
+#include "rsa__debug.h"
+#include "rsa_math__utils.h"
+#include "rsa_math__workspace.h"
+#include "rsa_math_ops__blocks.h"
+#include "rsa_math_ops__multiplication.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace rsa
+{
+
+	namespace math
+	{
+
+		namespace ops
+		{
+
+			namespace blocks
+			{
+
+				// the number of leading zero bits in x, i.e. the shift needed to normalize a divisor with x as its top block. x must not be zero.
+				template<class block_t>
+				std::uint32_t normalization_shift(block_t x)
+				{
+					debug::die_if(x == 0u);
+
+					auto shift = utils::digits<block_t>();
+
+					while (x != 0u)
+					{
+						--shift;
+						x >>= 1u;
+					}
+
+					return shift;
+				}
+
+				// q[0, nn) = n[0, nn) / d, returns the remainder. d must not be zero (and needn't be normalized). q may be the same as n.
+				template<class block_t>
+				block_t divrem_1(block_t* q, block_t const* n, std::size_t nn, block_t d)
+				{
+					using double_block_t = typename block_traits<block_t>::double_block_type;
+
+					debug::die_if(d == 0u);
+
+					auto k = double_block_t{ 0 };
+
+					for (auto i = nn; i != 0u; --i)
+					{
+						k = static_cast<double_block_t>((k << utils::digits<block_t>()) | n[i - 1u]);
+						q[i - 1u] = static_cast<block_t>(k / d);
+						k = static_cast<double_block_t>(k - static_cast<double_block_t>(q[i - 1u]) * d);
+					}
+
+					return static_cast<block_t>(k);
+				}
+
+				// returns n[0, nn) % d. d must not be zero (and needn't be normalized).
+				template<class block_t>
+				block_t mod_1(block_t const* n, std::size_t nn, block_t d)
+				{
+					using double_block_t = typename block_traits<block_t>::double_block_type;
+
+					debug::die_if(d == 0u);
+
+					auto k = double_block_t{ 0 };
+
+					for (auto i = nn; i != 0u; --i)
+					{
+						k = static_cast<double_block_t>((k << utils::digits<block_t>()) | n[i - 1u]);
+						k = static_cast<double_block_t>(k % d);
+					}
+
+					return static_cast<block_t>(k);
+				}
+
+				// r[j] = n[0, nn) % d[j] for j in [0, dn), in one pass over n. the divisors must not be zero (and needn't be normalized).
+				template<class block_t>
+				void mod_1_n(block_t* r, block_t const* n, std::size_t nn, block_t const* d, std::size_t dn)
+				{
+					using double_block_t = typename block_traits<block_t>::double_block_type;
+
+					for (auto j = std::size_t{ 0 }; j != dn; ++j)
+					{
+						debug::die_if(d[j] == 0u);
+						r[j] = block_t{ 0 };
+					}
+
+					for (auto i = nn; i != 0u; --i)
+					{
+						for (auto j = std::size_t{ 0 }; j != dn; ++j)
+						{
+							auto const k = static_cast<double_block_t>((static_cast<double_block_t>(r[j]) << utils::digits<block_t>()) | n[i - 1u]);
+							r[j] = static_cast<block_t>(k % d[j]);
+						}
+					}
+				}
+
+				// the division functions below all require a normalized divisor (the top bit of the top block set),
+				// and leave the remainder in the low blocks of n.
+
+				// q[0, nn - dn) = n[0, nn) / d[0, dn), n[0, dn) = n[0, nn) % d[0, dn). returns the high quotient block (0 or 1).
+				// requires nn >= dn > 0. q must not overlap n or d, and may be null if only the remainder is needed.
+				// (knuth, the art of computer programming vol. 2, algorithm D).
+				template<class block_t>
+				block_t divrem_basecase(block_t* q, block_t* n, std::size_t nn, block_t const* d, std::size_t dn)
+				{
+					using double_block_t = typename block_traits<block_t>::double_block_type;
+
+					debug::die_if(dn == 0u || nn < dn);
+					debug::die_if((d[dn - 1u] >> (utils::digits<block_t>() - 1u)) == 0u);
+
+					auto const promote = [] (double_block_t b) { return static_cast<double_block_t>(b << utils::digits<block_t>()); };
+
+					// the top dn blocks of n may be (at most once) larger than d
+					auto q_high = block_t{ 0 };
+
+					if (cmp(n + (nn - dn), dn, d, dn) >= 0)
+					{
+						sub_n(n + (nn - dn), n + (nn - dn), d, dn);
+						q_high = block_t{ 1 };
+					}
+
+					auto const b = static_cast<double_block_t>(promote(1u));
+					auto const v = d[dn - 1u];
+
+					for (auto j = nn - dn; j != 0u; )
+					{
+						--j;
+
+						// take the top two blocks of n, divide by top block of d, calc remainder
+						auto const n_block = static_cast<double_block_t>(promote(n[j + dn]) | n[j + dn - 1u]);
+						auto qhat = static_cast<double_block_t>(n_block / v);
+						auto rhat = static_cast<double_block_t>(n_block - qhat * v);
+
+						// q is too big or (looking at next block) remainder is smaller than what will be taken away
+						while (qhat >= b || (dn > 1u && (qhat * d[dn - 2u]) > (promote(rhat) + n[j + dn - 2u])))
+						{
+							qhat -= 1u; rhat += v;
+							if (rhat >= b) break;
+						}
+
+						// qhat is now correct, or 1 too high (extremely rare)
+
+						// multiply divisor by qhat and subtract from n
+						auto const borrow = submul_1(n + j, d, dn, static_cast<block_t>(qhat));
+						auto const underflow = (n[j + dn] < borrow);
+						n[j + dn] = block_t(n[j + dn] - borrow);
+
+						// underflow! (qhat was 1 too high)
+						// decrement q and add back one divisor to the remainder
+						if (underflow)
+						{
+							qhat -= 1u;
+							n[j + dn] = block_t(n[j + dn] + add_n(n + j, n + j, d, dn));
+						}
+
+						debug::die_if(n[j + dn] != 0u);
+
+						if (q)
+							q[j] = static_cast<block_t>(qhat);
+					}
+
+					return q_high;
+				}
+
+				template<class block_t>
+				block_t divrem_dc_n(block_t* q, block_t* n, block_t const* d, std::size_t size, workspace<block_t>& ws);
+
+				// subtracts q[0, qn) * d[0, qn + ln) from the partial remainder n[0, 2qn + ln), after the top qn blocks of d were
+				// used to find q (and its high block q_high). corrects q (and q_high) while the result is negative. returns q_high.
+				template<class block_t>
+				block_t divrem_correct(block_t* q, std::size_t qn, block_t q_high, block_t* n, block_t const* d, std::size_t ln, workspace<block_t>& ws)
+				{
+					// d = dh * B^ln + dl. n[ln, ln + qn) holds the remainder of the division by dh.
+
+					if (ln == 0u)
+						return q_high;
+
+					auto frame = typename workspace<block_t>::frame(ws);
+					auto const product = frame.allocate(qn + ln);
+					mul(product, q, qn, d, ln, ws);
+
+					auto borrow = static_cast<block_t>(sub(n, n, qn + ln, product, qn + ln));
+
+					if (q_high != 0u)
+						borrow = static_cast<block_t>(borrow + sub(n + qn, n + qn, ln, d, ln));
+
+					while (borrow != 0u)
+					{
+						q_high = static_cast<block_t>(q_high - (sub_1(q, q, qn, block_t{ 1 })));
+						borrow = static_cast<block_t>(borrow - add_n(n, n, d, qn + ln));
+					}
+
+					return q_high;
+				}
+
+				// q[0, size) = n[0, 2 size) / d[0, size), n[0, size) = remainder. returns the high quotient block.
+				// (burnikel & ziegler, "fast recursive division", in the form used by gmp.)
+				template<class block_t>
+				block_t divrem_dc_n(block_t* q, block_t* n, block_t const* d, std::size_t size, workspace<block_t>& ws)
+				{
+					auto const threshold = std::max<std::size_t>(thresholds().burnikel_ziegler, 2u);
+
+					auto const lo = size / 2u;
+					auto const hi = size - lo;
+
+					// divide the top 2hi blocks of n by the top hi blocks of d, giving the high hi blocks of q
+					auto q_high = (hi < threshold) ?
+						divrem_basecase(q + lo, n + 2u * lo, 2u * hi, d + lo, hi) :
+						divrem_dc_n(q + lo, n + 2u * lo, d + lo, hi, ws);
+
+					// subtract the rest of q_h * d
+					q_high = divrem_correct(q + lo, hi, q_high, n + lo, d, lo, ws);
+
+					// the same for the low lo blocks of q
+					auto const q_low = (lo < threshold) ?
+						divrem_basecase(q, n + hi, 2u * lo, d + hi, lo) :
+						divrem_dc_n(q, n + hi, d + hi, lo, ws);
+
+					auto const carry = divrem_correct(q, lo, q_low, n, d, hi, ws);
+					debug::die_if(carry != 0u);
+
+					return q_high;
+				}
+
+				// whether divrem uses schoolbook division for these sizes (in which case the quotient needn't be stored).
+				inline bool divrem_is_basecase(std::size_t nn, std::size_t dn)
+				{
+					auto const threshold = std::max<std::size_t>(thresholds().burnikel_ziegler, 2u);
+					return (dn < threshold || nn - dn < threshold);
+				}
+
+				// q[0, nn - dn) = n[0, nn) / d[0, dn), n[0, dn) = remainder. returns the high quotient block (0 or 1).
+				// requires nn >= dn > 0. q must not overlap n or d. q may be null if divrem_is_basecase(nn, dn).
+				template<class block_t>
+				block_t divrem(block_t* q, block_t* n, std::size_t nn, block_t const* d, std::size_t dn, workspace<block_t>& ws = default_workspace<block_t>())
+				{
+					if (divrem_is_basecase(nn, dn))
+						return divrem_basecase(q, n, nn, d, dn);
+
+					debug::die_if(!q);
+
+					auto const threshold = std::max<std::size_t>(thresholds().burnikel_ziegler, 2u);
+					auto const qn = nn - dn;
+
+					// the quotient is calculated in pieces of (at most) dn blocks, from the top.
+					// the first piece takes the leftover blocks, so the rest are all 2dn / dn divisions.
+					auto const first = (qn % dn == 0u) ? dn : (qn % dn);
+					auto j = qn - first;
+
+					// first piece (divide by the top `first` blocks of d, then correct with the rest)
+					auto q_high = (first < threshold) ?
+						divrem_basecase(q + j, n + j + (dn - first), 2u * first, d + (dn - first), first) :
+						divrem_dc_n(q + j, n + j + (dn - first), d + (dn - first), first, ws);
+
+					q_high = divrem_correct(q + j, first, q_high, n + j, d, dn - first, ws);
+
+					while (j != 0u)
+					{
+						j -= dn;
+
+						auto const carry = divrem_dc_n(q + j, n + j, d, dn, ws);
+						debug::die_if(carry != 0u);
+					}
+
+					return q_high;
+				}
+
+				// q[0, nn - dn + 1) = n[0, nn) / d[0, dn), r[0, dn) = n[0, nn) % d[0, dn). requires nn >= dn > 0, and d[dn - 1] != 0
+				// (d needn't be normalized). q may be null if only the remainder is needed.
+				// n and d are read (or copied to ws) before q or r are written, so q and r may each be the same as n or d, but not each other.
+				template<class block_t>
+				void tdiv_qr(block_t* q, block_t* r, block_t const* n, std::size_t nn, block_t const* d, std::size_t dn, workspace<block_t>& ws = default_workspace<block_t>())
+				{
+					debug::die_if(dn == 0u || nn < dn);
+					debug::die_if(d[dn - 1u] == 0u);
+
+					// single block divisor
+					if (dn == 1u)
+					{
+						r[0] = q ? divrem_1(q, n, nn, d[0]) : mod_1(n, nn, d[0]);
+						return;
+					}
+
+					// normalize copies of n and d. n gets an extra high block, so the high quotient block is always zero.
+					auto const shift = normalization_shift(d[dn - 1u]);
+
+					auto frame = typename workspace<block_t>::frame(ws);
+					auto const n_norm = frame.allocate(nn + 1u);
+					auto const d_norm = frame.allocate(dn);
+
+					if (shift != 0u)
+					{
+						n_norm[nn] = lshift(n_norm, n, nn, shift);
+						lshift(d_norm, d, dn, shift);
+					}
+					else
+					{
+						n_norm[nn] = block_t{ 0 };
+						std::copy(n, n + nn, n_norm);
+						std::copy(d, d + dn, d_norm);
+					}
+
+					auto const q_out = (q || divrem_is_basecase(nn + 1u, dn)) ? q : frame.allocate(nn + 1u - dn);
+					auto const q_high = divrem(q_out, n_norm, nn + 1u, d_norm, dn, ws);
+					debug::die_if(q_high != 0u);
+
+					// shift remainder back
+					if (shift != 0u)
+						rshift(r, n_norm, dn, shift);
+					else
+						std::copy(n_norm, n_norm + dn, r);
+				}
+
+			} // blocks
+
+		} // ops
+
+	} // math
+
+} // rsa
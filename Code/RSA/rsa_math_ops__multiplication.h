@@ -0,0 +1,503 @@
+#pragma once
+
+#include "rsa__debug.h"
+#include "rsa_math__utils.h"
+#include "rsa_math__workspace.h"
+#include "rsa_math_ops__blocks.h"
+#include "rsa_math_ops__ntt.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// operands with fewer blocks than these use schoolbook / karatsuba / toom-3 multiplication respectively.
+// may also be changed at runtime with ops::thresholds().
+#ifndef RSA_MATH_KARATSUBA_THRESHOLD
+#define RSA_MATH_KARATSUBA_THRESHOLD 32
+#endif
+
+#ifndef RSA_MATH_TOOM3_THRESHOLD
+#define RSA_MATH_TOOM3_THRESHOLD 192
+#endif
+
+#ifndef RSA_MATH_NTT_THRESHOLD
+#define RSA_MATH_NTT_THRESHOLD 16384
+#endif
+
+// divisors (and quotients) with fewer blocks than this use schoolbook (knuth) division, larger ones burnikel-ziegler division.
+#ifndef RSA_MATH_BURNIKEL_ZIEGLER_THRESHOLD
+#define RSA_MATH_BURNIKEL_ZIEGLER_THRESHOLD 64
+#endif
+
+namespace rsa
+{
+
+	namespace math
+	{
+
+		namespace ops
+		{
+
+			struct thresholds_type
+			{
+				std::size_t karatsuba;
+				std::size_t toom3;
+				std::size_t ntt;
+				std::size_t burnikel_ziegler = RSA_MATH_BURNIKEL_ZIEGLER_THRESHOLD;
+			};
+
+			// runtime tuning knobs (block counts) for the multiplication and division algorithms.
+			// note: these are shared by all block types, and aren't synchronized.
+			inline thresholds_type& thresholds()
+			{
+				static auto values = thresholds_type{ RSA_MATH_KARATSUBA_THRESHOLD, RSA_MATH_TOOM3_THRESHOLD, RSA_MATH_NTT_THRESHOLD };
+				return values;
+			}
+
+			namespace blocks
+			{
+
+				// note: the multiplication functions take their scratch space from ws.
+
+				template<class block_t>
+				void mul_n(block_t* r, block_t const* a, block_t const* b, std::size_t n, workspace<block_t>& ws = default_workspace<block_t>());
+
+				template<class block_t>
+				void mul(block_t* r, block_t const* a, std::size_t an, block_t const* b, std::size_t bn, workspace<block_t>& ws = default_workspace<block_t>());
+
+				template<class block_t>
+				void sqr_n(block_t* r, block_t const* a, std::size_t n, workspace<block_t>& ws = default_workspace<block_t>());
+
+				// r[0, an + bn) = a[0, an) * b[0, bn). requires an >= bn > 0. r must not overlap a or b.
+				template<class block_t>
+				void mul_basecase(block_t* r, block_t const* a, std::size_t an, block_t const* b, std::size_t bn)
+				{
+					debug::die_if(an < bn);
+					debug::die_if(bn == 0u);
+
+					r[an] = mul_1(r, a, an, b[0]);
+
+					for (auto i = std::size_t{ 1 }; i != bn; ++i)
+						r[an + i] = addmul_1(r + i, a, an, b[i]);
+				}
+
+				// r[0, n) = the low n blocks of a[0, an) * b[0, bn). requires an, bn > 0. r must not overlap a or b.
+				template<class block_t>
+				void mul_low_basecase(block_t* r, block_t const* a, std::size_t an, block_t const* b, std::size_t bn, std::size_t n)
+				{
+					std::fill(r, r + n, block_t{ 0 });
+
+					for (auto i = std::size_t{ 0 }; i != an && i != n; ++i)
+					{
+						auto const count = std::min(bn, n - i);
+						auto const carry = addmul_1(r + i, b, count, a[i]);
+
+						if (i + count != n)
+							add_1(r + i + count, r + i + count, n - i - count, carry);
+					}
+				}
+
+				// r[0, an + bn) = a[0, an) * b[0, bn), leaving out the partial products a[i] * b[j] with i + j < skip.
+				// the result is less than the true product by less than skip * B^(skip + 1). r must not overlap a or b.
+				template<class block_t>
+				void mul_high_basecase(block_t* r, block_t const* a, std::size_t an, block_t const* b, std::size_t bn, std::size_t skip)
+				{
+					std::fill(r, r + an + bn, block_t{ 0 });
+
+					for (auto i = std::size_t{ 0 }; i != an; ++i)
+					{
+						auto const j = (skip > i) ? std::min(skip - i, bn) : std::size_t{ 0 };
+
+						if (j != bn)
+							r[i + bn] = addmul_1(r + i + j, b + j, bn - j, a[i]);
+					}
+				}
+
+				// r[0, 2n) = a[0, n) * b[0, n). r must not overlap a or b.
+				template<class block_t>
+				void mul_karatsuba(block_t* r, block_t const* a, block_t const* b, std::size_t n, workspace<block_t>& ws)
+				{
+					// a = a1 * B^l + a0, b = b1 * B^l + b0
+					// a * b = z2 * B^2l + (z1 - z2 - z0) * B^l + z0
+					// where z0 = a0 * b0, z2 = a1 * b1, z1 = (a0 + a1) * (b0 + b1)
+
+					// note: n must be at least 4, or the middle product is no smaller than the original
+					debug::die_if(n < 4u);
+
+					auto const l = n / 2u;
+					auto const h = n - l;
+
+					auto frame = typename workspace<block_t>::frame(ws);
+					auto const sa = frame.allocate(4u * (h + 1u));
+					auto const sb = sa + (h + 1u);
+					auto const z1 = sb + (h + 1u);
+
+					sa[h] = add(sa, a + l, h, a, l);
+					sb[h] = add(sb, b + l, h, b, l);
+
+					// z0 and z2 go straight into the output
+					mul_n(r, a, b, l, ws);
+					mul_n(r + 2u * l, a + l, b + l, h, ws);
+					mul_n(z1, sa, sb, h + 1u, ws);
+
+					auto borrow = sub(z1, z1, 2u * (h + 1u), r, 2u * l);
+					borrow += sub(z1, z1, 2u * (h + 1u), r + 2u * l, 2u * h);
+					debug::die_if(borrow != 0u);
+
+					// the middle term is less than 2 * B^n so always fits in the output
+					auto const carry = add(r + l, r + l, n + h, z1, 2u * (h + 1u));
+					debug::die_if(carry != 0u);
+				}
+
+				// r[0, 2n) = a[0, n)^2. requires n > 0. r must not overlap a.
+				template<class block_t>
+				void sqr_basecase(block_t* r, block_t const* a, std::size_t n)
+				{
+					using double_block_t = typename block_traits<block_t>::double_block_type;
+
+					debug::die_if(n == 0u);
+
+					// the off-diagonal products a[i] * a[j] (i < j) are only calculated once, then doubled
+					std::fill(r, r + n, block_t{ 0 });
+
+					for (auto i = std::size_t{ 0 }; i + 1u < n; ++i)
+						r[i + n] = addmul_1(r + 2u * i + 1u, a + i + 1u, n - i - 1u, a[i]);
+
+					r[2u * n - 1u] = lshift(r, r, 2u * n - 1u, 1u);
+
+					// add the diagonal products a[i] * a[i]
+					auto carry = double_block_t{ 0 };
+
+					for (auto i = std::size_t{ 0 }; i != n; ++i)
+					{
+						auto const d = static_cast<double_block_t>(static_cast<double_block_t>(a[i]) * static_cast<double_block_t>(a[i]));
+
+						carry += static_cast<double_block_t>(r[2u * i]) + static_cast<block_t>(d);
+						r[2u * i] = static_cast<block_t>(carry);
+						carry >>= utils::digits<block_t>();
+
+						carry += static_cast<double_block_t>(r[2u * i + 1u]) + static_cast<block_t>(d >> utils::digits<block_t>());
+						r[2u * i + 1u] = static_cast<block_t>(carry);
+						carry >>= utils::digits<block_t>();
+					}
+
+					debug::die_if(carry != 0u);
+				}
+
+				// r[0, 2n) = a[0, n)^2. r must not overlap a.
+				template<class block_t>
+				void sqr_karatsuba(block_t* r, block_t const* a, std::size_t n, workspace<block_t>& ws)
+				{
+					// as mul_karatsuba, with z1 = (a0 + a1)^2
+
+					debug::die_if(n < 4u);
+
+					auto const l = n / 2u;
+					auto const h = n - l;
+
+					auto frame = typename workspace<block_t>::frame(ws);
+					auto const sa = frame.allocate(3u * (h + 1u));
+					auto const z1 = sa + (h + 1u);
+
+					sa[h] = add(sa, a + l, h, a, l);
+
+					sqr_n(r, a, l, ws);
+					sqr_n(r + 2u * l, a + l, h, ws);
+					sqr_n(z1, sa, h + 1u, ws);
+
+					auto borrow = sub(z1, z1, 2u * (h + 1u), r, 2u * l);
+					borrow += sub(z1, z1, 2u * (h + 1u), r + 2u * l, 2u * h);
+					debug::die_if(borrow != 0u);
+
+					auto const carry = add(r + l, r + l, n + h, z1, 2u * (h + 1u));
+					debug::die_if(carry != 0u);
+				}
+
+				// sign-magnitude value, used for the negative intermediates in toom-cook multiplication. the magnitudes are taken
+				// from a workspace frame (each operation makes a new one, and they're all released with the frame).
+				template<class block_t>
+				struct signed_blocks
+				{
+					block_t* magnitude;
+					std::size_t size; // no high zero blocks
+					bool negative;
+				};
+
+				template<class block_t>
+				signed_blocks<block_t> make_signed_blocks(typename workspace<block_t>::frame& frame, block_t const* a, std::size_t n)
+				{
+					n = normalized_size(a, n);
+
+					auto const magnitude = frame.allocate(n);
+					std::copy(a, a + n, magnitude);
+
+					return{ magnitude, n, false };
+				}
+
+				// returns x + y (or x - y if negate_y is true).
+				template<class block_t>
+				signed_blocks<block_t> signed_add(typename workspace<block_t>::frame& frame, signed_blocks<block_t> const& x, signed_blocks<block_t> const& y, bool negate_y = false)
+				{
+					auto const y_negative = (y.negative != negate_y);
+
+					auto result = signed_blocks<block_t>{ nullptr, 0u, x.negative };
+
+					if (x.negative == y_negative)
+					{
+						auto const& big = (x.size < y.size) ? y : x;
+						auto const& small = (x.size < y.size) ? x : y;
+
+						result.magnitude = frame.allocate(big.size + 1u);
+						result.magnitude[big.size] = add(result.magnitude, big.magnitude, big.size, small.magnitude, small.size);
+						result.size = big.size + 1u;
+					}
+					else
+					{
+						auto const x_bigger = (cmp(x.magnitude, x.size, y.magnitude, y.size) >= 0);
+						auto const& big = x_bigger ? x : y;
+						auto const& small = x_bigger ? y : x;
+
+						result.negative = (x_bigger ? x.negative : y_negative);
+						result.magnitude = frame.allocate(big.size);
+						sub(result.magnitude, big.magnitude, big.size, small.magnitude, small.size);
+						result.size = big.size;
+					}
+
+					result.size = normalized_size(result.magnitude, result.size);
+
+					if (result.size == 0u)
+						result.negative = false;
+
+					return result;
+				}
+
+				// returns x * y. the product's scratch space is taken from ws (after the result is allocated from frame).
+				template<class block_t>
+				signed_blocks<block_t> signed_mul(typename workspace<block_t>::frame& frame, signed_blocks<block_t> const& x, signed_blocks<block_t> const& y, workspace<block_t>& ws)
+				{
+					if (x.size == 0u || y.size == 0u)
+						return{ nullptr, 0u, false };
+
+					auto result = signed_blocks<block_t>{ frame.allocate(x.size + y.size), x.size + y.size, (x.negative != y.negative) };
+					mul(result.magnitude, x.magnitude, x.size, y.magnitude, y.size, ws);
+					result.size = normalized_size(result.magnitude, result.size);
+
+					return result;
+				}
+
+				// returns x * m, for small m
+				template<class block_t>
+				signed_blocks<block_t> signed_mul_1(typename workspace<block_t>::frame& frame, signed_blocks<block_t> const& x, block_t m)
+				{
+					if (x.size == 0u)
+						return x;
+
+					auto result = signed_blocks<block_t>{ frame.allocate(x.size + 1u), x.size, x.negative };
+					auto const carry = mul_1(result.magnitude, x.magnitude, x.size, m);
+
+					if (carry != 0u)
+						result.magnitude[result.size++] = carry;
+
+					return result;
+				}
+
+				// x /= 2, where x is known to be even
+				template<class block_t>
+				void signed_divexact_by2(signed_blocks<block_t>& x)
+				{
+					if (x.size == 0u)
+						return;
+
+					auto const remainder = rshift(x.magnitude, x.magnitude, x.size, 1u);
+					debug::die_if(remainder != 0u);
+
+					if (x.magnitude[x.size - 1u] == 0u)
+						--x.size;
+				}
+
+				// x /= 3, where x is known to be a multiple of 3
+				template<class block_t>
+				void signed_divexact_by3(signed_blocks<block_t>& x)
+				{
+					if (x.size == 0u)
+						return;
+
+					divexact_by3(x.magnitude, x.magnitude, x.size);
+					x.size = normalized_size(x.magnitude, x.size);
+				}
+
+				// r[0, 2n) = a[0, n) * b[0, n). r must not overlap a or b.
+				template<class block_t>
+				void mul_toom3(block_t* r, block_t const* a, block_t const* b, std::size_t n, workspace<block_t>& ws)
+				{
+					// a = a2 * x^2 + a1 * x + a0 (where x = B^k), similarly for b.
+					// evaluate at 0, 1, -1, -2, inf, multiply pointwise, then interpolate (bodrato's sequence).
+
+					// note: n must be large enough that the evaluated pieces (k + 2 blocks) are smaller than the original
+					debug::die_if(n < 9u);
+
+					auto const k = (n + 2u) / 3u;
+					auto const s = n - 2u * k;
+
+					debug::die_if(s == 0u || s > k);
+
+					using value_t = signed_blocks<block_t>;
+
+					// (the intermediates are all O(k) blocks, so taking them from one frame uses O(n) of the workspace)
+					auto frame = typename workspace<block_t>::frame(ws);
+
+					auto const evaluate = [&] (block_t const* p, value_t& p_1, value_t& p_m1, value_t& p_m2)
+					{
+						auto const p0 = make_signed_blocks(frame, p, k);
+						auto const p1 = make_signed_blocks(frame, p + k, k);
+						auto const p2 = make_signed_blocks(frame, p + 2u * k, s);
+
+						auto const p02 = signed_add(frame, p0, p2);
+						p_1 = signed_add(frame, p02, p1);
+						p_m1 = signed_add(frame, p02, p1, true);
+						p_m2 = signed_add(frame, p_m1, p2);
+						p_m2 = signed_mul_1(frame, p_m2, block_t{ 2 });
+						p_m2 = signed_add(frame, p_m2, p0, true);
+					};
+
+					auto a_1 = value_t(), a_m1 = value_t(), a_m2 = value_t();
+					auto b_1 = value_t(), b_m1 = value_t(), b_m2 = value_t();
+					evaluate(a, a_1, a_m1, a_m2);
+
+					// when squaring, evaluate once (the pointwise products then become squares too)
+					auto const squaring = (a == b);
+
+					if (!squaring)
+						evaluate(b, b_1, b_m1, b_m2);
+
+					// r0 = a0 * b0 and r4 = a2 * b2 go straight into the output (the gap between them is zeroed)
+					mul_n(r, a, b, k, ws);
+					std::fill(r + 2u * k, r + 4u * k, block_t{ 0 });
+					mul_n(r + 4u * k, a + 2u * k, b + 2u * k, s, ws);
+
+					auto const r0 = make_signed_blocks(frame, r, 2u * k);
+					auto const r4 = make_signed_blocks(frame, r + 4u * k, 2u * s);
+
+					auto r1 = signed_mul(frame, a_1, squaring ? a_1 : b_1, ws);
+					auto const r_m1 = signed_mul(frame, a_m1, squaring ? a_m1 : b_m1, ws);
+					auto r3 = signed_mul(frame, a_m2, squaring ? a_m2 : b_m2, ws);
+
+					// r3 = (r(-2) - r(1)) / 3
+					r3 = signed_add(frame, r3, r1, true);
+					signed_divexact_by3(r3);
+
+					// r1 = (r(1) - r(-1)) / 2
+					r1 = signed_add(frame, r1, r_m1, true);
+					signed_divexact_by2(r1);
+
+					// r2 = r(-1) - r(0)
+					auto r2 = signed_add(frame, r_m1, r0, true);
+
+					// r3 = (r2 - r3) / 2 + 2 * r(inf)
+					r3 = signed_add(frame, r2, r3, true);
+					signed_divexact_by2(r3);
+					r3 = signed_add(frame, r3, r4);
+					r3 = signed_add(frame, r3, r4);
+
+					// r2 = r2 + r1 - r(inf)
+					r2 = signed_add(frame, r2, r1);
+					r2 = signed_add(frame, r2, r4, true);
+
+					// r1 = r1 - r3
+					r1 = signed_add(frame, r1, r3, true);
+
+					// the remaining coefficients are all non-negative, add them in at their offsets
+					auto const add_at = [&] (value_t const& v, std::size_t offset)
+					{
+						debug::die_if(v.negative);
+						debug::die_if(offset + v.size > 2u * n);
+
+						auto const carry = add(r + offset, r + offset, 2u * n - offset, v.magnitude, v.size);
+						debug::die_if(carry != 0u);
+					};
+
+					add_at(r1, k);
+					add_at(r2, 2u * k);
+					add_at(r3, 3u * k);
+				}
+
+				// r[0, 2n) = a[0, n)^2. r must not overlap a.
+				template<class block_t>
+				void sqr_n(block_t* r, block_t const* a, std::size_t n, workspace<block_t>& ws)
+				{
+					if (n < std::max<std::size_t>(thresholds().karatsuba, 4u))
+						sqr_basecase(r, a, n);
+					else if (n < std::max<std::size_t>(thresholds().toom3, 9u))
+						sqr_karatsuba(r, a, n, ws);
+					else if (n < thresholds().ntt || !ntt::can_multiply<block_t>(n, n))
+						mul_toom3(r, a, a, n, ws);
+					else
+						mul_ntt(r, a, n, a, n);
+				}
+
+				// r[0, 2n) = a[0, n) * b[0, n). r must not overlap a or b.
+				template<class block_t>
+				void mul_n(block_t* r, block_t const* a, block_t const* b, std::size_t n, workspace<block_t>& ws)
+				{
+					if (a == b)
+						return sqr_n(r, a, n, ws);
+
+					if (n < std::max<std::size_t>(thresholds().karatsuba, 4u))
+						mul_basecase(r, a, n, b, n);
+					else if (n < std::max<std::size_t>(thresholds().toom3, 9u))
+						mul_karatsuba(r, a, b, n, ws);
+					else if (n < thresholds().ntt || !ntt::can_multiply<block_t>(n, n))
+						mul_toom3(r, a, b, n, ws);
+					else
+						mul_ntt(r, a, n, b, n);
+				}
+
+				// r[0, an + bn) = a[0, an) * b[0, bn). requires an, bn > 0. r must not overlap a or b.
+				template<class block_t>
+				void mul(block_t* r, block_t const* a, std::size_t an, block_t const* b, std::size_t bn, workspace<block_t>& ws)
+				{
+					if (an < bn)
+					{
+						std::swap(a, b);
+						std::swap(an, bn);
+					}
+
+					debug::die_if(bn == 0u);
+
+					if (a == b && an == bn)
+						return sqr_n(r, a, an, ws);
+
+					if (bn < thresholds().karatsuba)
+						return mul_basecase(r, a, an, b, bn);
+
+					if (an == bn)
+						return mul_n(r, a, b, bn, ws);
+
+					// the transform handles unbalanced operands directly
+					if (bn >= thresholds().ntt && ntt::can_multiply<block_t>(an, bn))
+						return mul_ntt(r, a, an, b, bn);
+
+					// unbalanced: multiply b by successive bn sized pieces of a
+					mul_n(r, a, b, bn, ws);
+					std::fill(r + 2u * bn, r + an + bn, block_t{ 0 });
+
+					auto frame = typename workspace<block_t>::frame(ws);
+					auto const temp = frame.allocate(2u * bn);
+
+					for (auto offset = bn; offset < an; offset += bn)
+					{
+						auto const size = std::min(bn, an - offset);
+						mul(temp, a + offset, size, b, bn, ws);
+
+						auto const carry = add(r + offset, r + offset, an + bn - offset, temp, size + bn);
+						debug::die_if(carry != 0u);
+					}
+				}
+
+			} // blocks
+
+		} // ops
+
+	} // math
+
+} // rsa
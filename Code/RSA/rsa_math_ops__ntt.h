@@ -0,0 +1,332 @@
+#pragma once
+
+#include "rsa__debug.h"
+#include "rsa_math__utils.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace rsa
+{
+
+	namespace math
+	{
+
+		namespace ops
+		{
+
+			namespace blocks
+			{
+
+				// number theoretic transform multiplication.
+				// operands are split into 16 bit digits, and convolved modulo three primes of the form c * 2^k + 1.
+				// the convolution coefficients are less than 2^55, so are recovered exactly with the chinese remainder theorem.
+				namespace ntt
+				{
+
+					struct prime
+					{
+						std::uint32_t modulus;
+						std::uint32_t generator; // primitive root
+					};
+
+					constexpr auto primes = std::array<prime, 3u>
+					{{
+						{ 998244353u, 3u }, // 119 * 2^23 + 1
+						{ 167772161u, 3u }, // 5 * 2^25 + 1
+						{ 469762049u, 3u }, // 7 * 2^26 + 1
+					}};
+
+					constexpr std::uint32_t digit_bits = 16u;
+					constexpr std::size_t max_size = std::size_t{ 1 } << 23u; // largest power of 2 dividing all (modulus - 1)
+
+					inline std::uint32_t mul_mod(std::uint32_t a, std::uint32_t b, std::uint32_t m)
+					{
+						return static_cast<std::uint32_t>((std::uint64_t{ a } * b) % m);
+					}
+
+					// multiplication by a constant w, using the precomputed w_shoup = floor(w * 2^32 / m) (shoup's method). requires m < 2^31.
+					inline std::uint32_t mul_mod_shoup(std::uint32_t a, std::uint32_t w, std::uint32_t w_shoup, std::uint32_t m)
+					{
+						auto const q = static_cast<std::uint32_t>((std::uint64_t{ a } * w_shoup) >> 32u);
+						auto const r = static_cast<std::uint32_t>(a * w - q * m);
+						return (r >= m) ? (r - m) : r;
+					}
+
+					inline std::uint32_t get_shoup(std::uint32_t w, std::uint32_t m)
+					{
+						return static_cast<std::uint32_t>((std::uint64_t{ w } << 32u) / m);
+					}
+
+					inline std::uint32_t pow_mod(std::uint32_t base, std::uint64_t exp, std::uint32_t m)
+					{
+						auto result = std::uint32_t{ 1 };
+
+						for (; exp != 0u; exp >>= 1u)
+						{
+							if (exp & 1u)
+								result = mul_mod(result, base, m);
+
+							base = mul_mod(base, base, m);
+						}
+
+						return result;
+					}
+
+					inline std::uint32_t inverse_mod(std::uint32_t a, std::uint32_t m)
+					{
+						return pow_mod(a, m - 2u, m); // m is prime
+					}
+
+					// powers of the roots of unity (or their inverses) for each stage of a transform, with their shoup constants.
+					// the stage of length l uses entries [l / 2, l).
+					struct root_table
+					{
+						std::vector<std::uint32_t> roots;
+						std::vector<std::uint32_t> roots_shoup;
+					};
+
+					inline root_table make_root_table(std::size_t n, prime const& p, bool inverse)
+					{
+						auto const m = p.modulus;
+						auto table = root_table{ std::vector<std::uint32_t>(n), std::vector<std::uint32_t>(n) };
+
+						for (auto length = std::size_t{ 2 }; length <= n; length <<= 1u)
+						{
+							auto root = pow_mod(p.generator, (m - 1u) / length, m);
+
+							if (inverse)
+								root = inverse_mod(root, m);
+
+							auto w = std::uint32_t{ 1 };
+
+							for (auto j = length / 2u; j != length; ++j)
+							{
+								table.roots[j] = w;
+								table.roots_shoup[j] = get_shoup(w, m);
+								w = mul_mod(w, root, m);
+							}
+						}
+
+						return table;
+					}
+
+					// the table of primes[index] (or its inverse) for transforms of up to n entries. the roots of a stage don't depend
+					// on the transform size, so one table per prime and direction is kept (per thread), and only rebuilt to grow it.
+					inline root_table const& get_root_table(std::size_t n, std::size_t index, bool inverse)
+					{
+						thread_local auto tables = std::array<root_table, 2u * primes.size()>();
+
+						auto& table = tables[2u * index + (inverse ? 1u : 0u)];
+
+						if (table.roots.size() < n)
+							table = make_root_table(n, primes[index], inverse);
+
+						return table;
+					}
+
+					// in place transform. a.size() must be a power of 2, and table must be made for at least that size.
+					inline void transform(std::vector<std::uint32_t>& a, prime const& p, root_table const& table, bool inverse)
+					{
+						auto const n = a.size();
+						auto const m = p.modulus;
+
+						// bit reversal permutation
+						for (auto i = std::size_t{ 1 }, j = std::size_t{ 0 }; i < n; ++i)
+						{
+							auto bit = n >> 1u;
+
+							for (; j & bit; bit >>= 1u)
+								j ^= bit;
+
+							j ^= bit;
+
+							if (i < j)
+								std::swap(a[i], a[j]);
+						}
+
+						for (auto length = std::size_t{ 2 }; length <= n; length <<= 1u)
+						{
+							auto const half = length / 2u;
+							auto const roots = table.roots.data() + half;
+							auto const roots_shoup = table.roots_shoup.data() + half;
+
+							for (auto i = std::size_t{ 0 }; i != n; i += length)
+							{
+								for (auto j = std::size_t{ 0 }; j != half; ++j)
+								{
+									auto const u = a[i + j];
+									auto const v = mul_mod_shoup(a[i + j + half], roots[j], roots_shoup[j], m);
+
+									a[i + j] = (u + v >= m) ? (u + v - m) : (u + v);
+									a[i + j + half] = (u >= v) ? (u - v) : (u + m - v);
+								}
+							}
+						}
+
+						if (inverse)
+						{
+							auto const n_inverse = inverse_mod(static_cast<std::uint32_t>(n % m), m);
+							auto const n_inverse_shoup = get_shoup(n_inverse, m);
+
+							for (auto& x : a)
+								x = mul_mod_shoup(x, n_inverse, n_inverse_shoup, m);
+						}
+					}
+
+					// the number of digits needed for n blocks
+					template<class block_t>
+					std::size_t digit_count(std::size_t n)
+					{
+						return (n * utils::digits<block_t>() + digit_bits - 1u) / digit_bits;
+					}
+
+					template<class block_t>
+					std::vector<std::uint32_t> to_digits(block_t const* a, std::size_t n, std::size_t size)
+					{
+						auto result = std::vector<std::uint32_t>(size);
+						auto const count = digit_count<block_t>(n);
+
+						if (utils::digits<block_t>() >= digit_bits)
+						{
+							auto const per_block = utils::digits<block_t>() / digit_bits;
+
+							for (auto i = std::size_t{ 0 }; i != count; ++i)
+								result[i] = static_cast<std::uint32_t>(a[i / per_block] >> (digit_bits * (i % per_block))) & 0xffffu;
+						}
+						else
+						{
+							auto const per_digit = digit_bits / utils::digits<block_t>();
+
+							for (auto i = std::size_t{ 0 }; i != n; ++i)
+								result[i / per_digit] |= static_cast<std::uint32_t>(a[i]) << (utils::digits<block_t>() * (i % per_digit));
+						}
+
+						return result;
+					}
+
+					template<class block_t>
+					void from_digits(block_t* r, std::size_t n, std::vector<std::uint32_t> const& digits)
+					{
+						std::fill(r, r + n, block_t{ 0 });
+
+						if (utils::digits<block_t>() >= digit_bits)
+						{
+							auto const per_block = utils::digits<block_t>() / digit_bits;
+							auto const count = std::min(digits.size(), n * per_block);
+
+							for (auto i = std::size_t{ 0 }; i != count; ++i)
+								r[i / per_block] |= static_cast<block_t>(static_cast<block_t>(digits[i]) << (digit_bits * (i % per_block)));
+						}
+						else
+						{
+							auto const per_digit = digit_bits / utils::digits<block_t>();
+
+							for (auto i = std::size_t{ 0 }; i != n && (i / per_digit) < digits.size(); ++i)
+								r[i] = static_cast<block_t>(digits[i / per_digit] >> (utils::digits<block_t>() * (i % per_digit)));
+						}
+					}
+
+					// true if a product of an and bn blocks fits within the maximum transform size.
+					template<class block_t>
+					bool can_multiply(std::size_t an, std::size_t bn)
+					{
+						return (digit_count<block_t>(an) + digit_count<block_t>(bn) <= max_size);
+					}
+
+				} // ntt
+
+				// r[0, an + bn) = a[0, an) * b[0, bn). requires ntt::can_multiply(an, bn). r must not overlap a or b.
+				// a and b may be the same range (squaring).
+				// note: unlike the other multiplications, this doesn't use a workspace. its digit and residue buffers hold 32 bit
+				// values whatever the block type, so they're std::vectors (from the default resource).
+				template<class block_t>
+				void mul_ntt(block_t* r, block_t const* a, std::size_t an, block_t const* b, std::size_t bn)
+				{
+					debug::die_if(!ntt::can_multiply<block_t>(an, bn));
+
+					auto const coefficients = ntt::digit_count<block_t>(an) + ntt::digit_count<block_t>(bn);
+
+					auto size = std::size_t{ 1 };
+
+					while (size < coefficients)
+						size <<= 1u;
+
+					// convolve modulo each prime
+					auto residues = std::array<std::vector<std::uint32_t>, ntt::primes.size()>();
+
+					for (auto i = std::size_t{ 0 }; i != ntt::primes.size(); ++i)
+					{
+						auto const& p = ntt::primes[i];
+						auto const& forward = ntt::get_root_table(size, i, false);
+						auto const& inverse = ntt::get_root_table(size, i, true);
+
+						auto fa = ntt::to_digits(a, an, size);
+						ntt::transform(fa, p, forward, false);
+
+						// squaring only needs one forward transform
+						if (a == b && an == bn)
+						{
+							for (auto& x : fa)
+								x = ntt::mul_mod(x, x, p.modulus);
+						}
+						else
+						{
+							auto fb = ntt::to_digits(b, bn, size);
+							ntt::transform(fb, p, forward, false);
+
+							for (auto j = std::size_t{ 0 }; j != size; ++j)
+								fa[j] = ntt::mul_mod(fa[j], fb[j], p.modulus);
+						}
+
+						ntt::transform(fa, p, inverse, true);
+
+						residues[i] = std::move(fa);
+					}
+
+					// recombine (garner's algorithm), and propagate carries
+					auto const p0 = ntt::primes[0].modulus;
+					auto const p1 = ntt::primes[1].modulus;
+					auto const p2 = ntt::primes[2].modulus;
+
+					auto const p0_inverse_mod_p1 = ntt::inverse_mod(p0 % p1, p1);
+					auto const p0_mod_p2 = p0 % p2;
+					auto const p0p1_inverse_mod_p2 = ntt::inverse_mod(ntt::mul_mod(p0_mod_p2, p1 % p2, p2), p2);
+
+					auto digits = std::vector<std::uint32_t>(coefficients);
+					auto carry = std::uint64_t{ 0 };
+
+					for (auto i = std::size_t{ 0 }; i != coefficients; ++i)
+					{
+						auto const r0 = residues[0][i];
+						auto const r1 = residues[1][i];
+						auto const r2 = residues[2][i];
+
+						auto const t1 = ntt::mul_mod((r1 + p1 - (r0 % p1)) % p1, p0_inverse_mod_p1, p1);
+						auto const x01_mod_p2 = static_cast<std::uint32_t>((r0 % p2 + std::uint64_t{ p0_mod_p2 } * t1) % p2);
+						auto const t2 = ntt::mul_mod((r2 + p2 - x01_mod_p2) % p2, p0p1_inverse_mod_p2, p2);
+
+						// the true coefficient is < 2^64, so wrapping arithmetic gives the exact value
+						auto const x = std::uint64_t{ r0 } + std::uint64_t{ p0 } * t1 + std::uint64_t{ p0 } * p1 * t2;
+
+						carry += x;
+						digits[i] = static_cast<std::uint32_t>(carry & 0xffffu);
+						carry >>= ntt::digit_bits;
+					}
+
+					debug::die_if(carry != 0u);
+
+					ntt::from_digits(r, an + bn, digits);
+				}
+
+			} // blocks
+
+		} // ops
+
+	} // math
+
+} // rsa
@@ -1,10 +1,16 @@
 #pragma once
 
 #include "rsa__debug.h"
+#include "rsa_math__big_uint_view.h"
 #include "rsa_math__utils.h"
+#include "rsa_math__workspace.h"
+#include "rsa_math_ops__blocks.h"
+#include "rsa_math_ops__division.h"
+#include "rsa_math_ops__multiplication.h"
 
 #include <algorithm>
 #include <stdexcept>
+#include <vector>
 
 namespace rsa
 {
@@ -18,37 +24,104 @@ namespace rsa
 		namespace ops
 		{
 
+			// the type of operands that are only read. big_uint and big_uint_view arguments both convert to it
+			// (the block type is deduced from the other arguments).
 			template<class block_t>
-			void bit_and_assign(big_uint<block_t>& a, big_uint<block_t> const& b)
+			using view_t = utils::identity_t<big_uint_view<block_t>>;
+
+			// compares a with b. returns -1, 0 or 1.
+			template<class block_t>
+			int cmp(big_uint_view<block_t> a, view_t<block_t> b)
 			{
-				const auto min_size = std::min(a.data().size(), b.data().size());
+				return blocks::cmp(a.data().data(), a.data().size(), b.data().data(), b.data().size());
+			}
 
-				for (auto i = std::size_t{ 0 }; i != min_size; ++i)
-					a.data()[i] &= b.data()[i];
+			// compares a with n. returns -1, 0 or 1.
+			template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			int cmp(big_uint_view<block_t> a, uint_t n)
+			{
+				auto const b = utils::to_blocks<block_t>(n);
+				return blocks::cmp(a.data().data(), a.data().size(), b.blocks.data(), b.size);
+			}
 
-				a.data().resize(min_size);
+			template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			int cmp(big_uint<block_t> const& a, uint_t n)
+			{
+				return cmp(big_uint_view<block_t>(a), n);
+			}
+
+			template<class block_t>
+			void bit_and_assign(big_uint<block_t>& a, view_t<block_t> b)
+			{
+				auto& a_data = a.data();
+				auto const min_size = std::min(a_data.size(), b.data().size());
+
+				a_data.resize(min_size);
+				blocks::and_n(a_data.data(), a_data.data(), b.data().data(), min_size);
+
+				utils::trim(a);
 			}
 
 			template<class block_t>
-			void bit_or_assign(big_uint<block_t>& a, big_uint<block_t> const& b)
+			void bit_or_assign(big_uint<block_t>& a, view_t<block_t> b)
 			{
-				const auto min_size = std::min(a.data().size(), b.data().size());
+				auto& a_data = a.data();
+				auto const b_data = b.data();
 
-				for (auto i = std::size_t{ 0 }; i != min_size; ++i)
-					a.data()[i] |= b.data()[i];
+				// (b is larger, so isn't a view of a)
+				if (a_data.size() < b_data.size())
+					a_data.resize(b_data.size());
 
-				std::copy(b.data().begin() + min_size, b.data().end(), std::back_inserter(a.data()));
+				blocks::ior_n(a_data.data(), a_data.data(), b_data.data(), b_data.size());
 			}
 
 			template<class block_t>
-			void bit_xor_assign(big_uint<block_t>& a, big_uint<block_t> const& b)
+			void bit_xor_assign(big_uint<block_t>& a, view_t<block_t> b)
 			{
-				const auto min_size = std::min(a.data().size(), b.data().size());
+				auto& a_data = a.data();
+				auto const b_data = b.data();
+
+				// (b is larger, so isn't a view of a)
+				if (a_data.size() < b_data.size())
+					a_data.resize(b_data.size());
+
+				blocks::xor_n(a_data.data(), a_data.data(), b_data.data(), b_data.size());
+
+				utils::trim(a);
+			}
 
-				for (auto i = std::size_t{ 0 }; i != min_size; ++i)
-					a.data()[i] ^= b.data()[i];
+			template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			void bit_and_assign(big_uint<block_t>& a, uint_t n)
+			{
+				auto const b = utils::to_blocks<block_t>(n);
+				auto const min_size = std::min(a.data().size(), b.size);
 
-				std::copy(b.data().begin() + min_size, b.data().end(), std::back_inserter(a.data()));
+				a.data().resize(min_size);
+				blocks::and_n(a.data().data(), a.data().data(), b.blocks.data(), min_size);
+
+				utils::trim(a);
+			}
+
+			template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			void bit_or_assign(big_uint<block_t>& a, uint_t n)
+			{
+				auto const b = utils::to_blocks<block_t>(n);
+
+				if (a.data().size() < b.size)
+					a.data().resize(b.size);
+
+				blocks::ior_n(a.data().data(), a.data().data(), b.blocks.data(), b.size);
+			}
+
+			template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			void bit_xor_assign(big_uint<block_t>& a, uint_t n)
+			{
+				auto const b = utils::to_blocks<block_t>(n);
+
+				if (a.data().size() < b.size)
+					a.data().resize(b.size);
+
+				blocks::xor_n(a.data().data(), a.data().data(), b.blocks.data(), b.size);
 
 				utils::trim(a);
 			}
@@ -65,38 +138,28 @@ namespace rsa
 				if (a.is_zero())
 					return;
 
-				// shift by whole blocks
-				if (n >= block_digits)
-				{
-					auto blocks = n / block_digits;
-					a.data().insert(a.data().begin(), blocks, block_t{ 0 });
-
-					n -= (blocks * block_digits);
+				auto const block_shift = static_cast<std::size_t>(n / block_digits);
+				auto const bit_shift = static_cast<std::uint32_t>(n % block_digits);
 
-					if (n == bit_index_t{ 0 })
-						return;
-				}
+				// make space for the whole blocks (and the bits shifted out of the top)
+				auto& a_data = a.data();
+				auto const size = a_data.size();
+				a_data.resize(size + block_shift + 1u);
 
-				debug::die_if(n >= block_digits);
-				const auto carry_shift = block_t(block_digits - n);
-				auto carry = block_t{ 0 };
+				auto const data = a_data.data();
 
-				// shift by partial blocks
-				for (auto& block : a.data())
+				// (shifting up, so the blocks overlap from above)
+				if (bit_shift != 0u)
+					data[size + block_shift] = blocks::lshift(data + block_shift, data, size, bit_shift);
+				else
 				{
-					// take high bits, shift them to low bits for next block (cast to fix type from integer promotion)
-					const auto carry_out = block_t(block >> carry_shift);
-
-					// shift low bits to high, apply carry bits
-					block = (block << n) | carry;
-
-					carry = carry_out;
+					std::copy_backward(data, data + size, data + size + block_shift);
+					data[size + block_shift] = block_t{ 0 };
 				}
 
-				if (carry != block_t{ 0 })
-					a.data().push_back(carry);
+				std::fill(data, data + block_shift, block_t{ 0 });
 
-				debug::die_if(utils::has_extra_empty_blocks(a));
+				utils::trim(a);
 			}
 
 			template<class block_t>
@@ -108,361 +171,496 @@ namespace rsa
 				if (n == bit_index_t{ 0 })
 					return;
 
-				if (a.is_zero())
-					return;
+				auto& a_data = a.data();
 
-				// shift by whole blocks
-				if (n >= block_digits)
+				if (n / block_digits >= a_data.size())
 				{
-					auto blocks = n / block_digits;
-					a.data().erase(a.data().begin(), a.data().begin() + std::min<std::size_t>(blocks, a.data().size()));
+					a_data.clear();
+					return;
+				}
 
-					if (a.is_zero())
-						return;
+				auto const block_shift = static_cast<std::size_t>(n / block_digits);
+				auto const bit_shift = static_cast<std::uint32_t>(n % block_digits);
+				auto const size = a_data.size() - block_shift;
 
-					n -= (blocks * block_digits);
+				auto const data = a_data.data();
 
-					if (n == bit_index_t{ 0 })
-						return;
-				}
+				// (shifting down, so the blocks overlap from below)
+				if (bit_shift != 0u)
+					blocks::rshift(data, data + block_shift, size, bit_shift);
+				else
+					std::copy(data + block_shift, data + block_shift + size, data);
 
-				debug::die_if(n >= block_digits);
-				const auto carry_shift = block_t(block_digits - n);
-				auto carry = block_t{ 0 };
+				a_data.resize(size);
 
-				// shift by partial blocks
-				for (auto i_block = a.data().rbegin(); i_block != a.data().rend(); ++i_block)
-				{
-					auto& block = *i_block;
+				utils::trim(a);
+			}
 
-					// take low bits, shift them to high bits for the next block (cast to fix type from integer promotion)
-					const auto carry_out = block_t(block << carry_shift);
+			template<class block_t>
+			void add_assign(big_uint<block_t>& a, view_t<block_t> b)
+			{
+				if (b.is_zero())
+					return;
 
-					// shift high bits to low, apply carry bits
-					block = (block >> n) | carry;
+				auto& a_data = a.data();
+				auto const b_data = b.data();
 
-					carry = carry_out;
-				}
+				// (b is larger, so isn't a view of a)
+				if (a_data.size() < b_data.size())
+					a_data.resize(b_data.size());
 
-				utils::trim(a);
+				auto const carry = blocks::add(a_data.data(), a_data.data(), a_data.size(), b_data.data(), b_data.size());
+
+				if (carry != 0u)
+					a_data.push_back(carry);
 			}
 
-			template<class block_t>
-			void add_assign(big_uint<block_t>& a, big_uint<block_t> const& b)
+			template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			void add_assign(big_uint<block_t>& a, uint_t n)
 			{
-				using double_block_t = typename big_uint<block_t>::double_block_type;
+				auto const b = utils::to_blocks<block_t>(n);
+
+				if (b.size == 0u)
+					return;
+
+				auto& a_data = a.data();
+
+				if (a_data.size() < b.size)
+					a_data.resize(b.size);
+
+				auto const carry = (b.size == 1u) ?
+					blocks::add_1(a_data.data(), a_data.data(), a_data.size(), b.blocks[0]) :
+					blocks::add(a_data.data(), a_data.data(), a_data.size(), b.blocks.data(), b.size);
+
+				if (carry != 0u)
+					a_data.push_back(carry);
+			}
 
+			template<class block_t>
+			void sub_assign(big_uint<block_t>& a, view_t<block_t> b)
+			{
 				if (b.is_zero())
 					return;
 
-				if (a.is_zero())
-				{
-					a = b;
+				if (cmp(b, a) > 0)
+					throw std::invalid_argument("cannot subtract larger value from smaller one.");
+
+				auto& a_data = a.data();
+				auto const b_data = b.data();
+
+				blocks::sub(a_data.data(), a_data.data(), a_data.size(), b_data.data(), b_data.size());
+
+				utils::trim(a);
+			}
+
+			template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			void sub_assign(big_uint<block_t>& a, uint_t n)
+			{
+				auto const b = utils::to_blocks<block_t>(n);
+
+				if (b.size == 0u)
 					return;
-				}
 
 				auto& a_data = a.data();
-				auto const& b_data = b.data();
-				const auto min_size = std::min(a_data.size(), b_data.size());
 
-				auto carry = double_block_t{ 0 };
+				if (blocks::cmp(a_data.data(), a_data.size(), b.blocks.data(), b.size) < 0)
+					throw std::invalid_argument("cannot subtract larger value from smaller one.");
 
-				// both a and b have data
-				for (auto i = std::size_t{ 0 }; i != min_size; ++i)
-				{
-					carry += static_cast<double_block_t>(a_data[i]) + static_cast<double_block_t>(b_data[i]);
-					a_data[i] = static_cast<block_t>(carry);
-					carry >>= utils::digits<block_t>();
-				}
+				if (b.size == 1u)
+					blocks::sub_1(a_data.data(), a_data.data(), a_data.size(), b.blocks[0]);
+				else
+					blocks::sub(a_data.data(), a_data.data(), a_data.size(), b.blocks.data(), b.size);
 
-				// ran out of data in a, copy over the rest of b
-				a_data.insert(a_data.end(), b_data.begin() + min_size, b_data.end());
+				utils::trim(a);
+			}
 
-				// add carry
-				for (auto i = min_size; i != a_data.size() && (carry != double_block_t{ 0 }); ++i)
-				{
-					carry += static_cast<double_block_t>(a_data[i]);
-					a_data[i] = static_cast<block_t>(carry);
-					carry >>= utils::digits<block_t>();
-				}
+			// whether the operand a is (a view of) the number out. (zero operands are never treated as the same, since nothing is read from them)
+			template<class block_t>
+			bool aliases(big_uint<block_t> const& out, big_uint_view<block_t> a)
+			{
+				return (a.data().data() == out.data().data() && !a.is_zero());
+			}
 
-				// extend a if necessary
-				if (carry)
-					a_data.push_back(static_cast<block_t>(carry));
+			// whether n's storage can hold size blocks without reallocating.
+			template<class block_t>
+			bool has_capacity(big_uint<block_t> const& n, std::size_t size)
+			{
+				return (n.data().capacity() >= size);
 			}
 
+			// out = a + b. out may be the same object as a or b, and otherwise reuses its existing storage.
 			template<class block_t>
-			void sub_assign(big_uint<block_t>& a, big_uint<block_t> const& b)
+			void add(big_uint<block_t>& out, view_t<block_t> a, view_t<block_t> b)
 			{
-				using double_block_t = typename big_uint<block_t>::double_block_type;
+				if (aliases(out, a)) { add_assign(out, b); return; }
+				if (aliases(out, b)) { add_assign(out, a); return; }
 
-				if (b.is_zero())
-					return;
+				auto const l = (a.data().size() < b.data().size()) ? b : a;
+				auto const s = (a.data().size() < b.data().size()) ? a : b;
+
+				auto& out_data = out.data();
+				out_data.resize(l.data().size());
+
+				auto const carry = blocks::add(out_data.data(), l.data().data(), l.data().size(), s.data().data(), s.data().size());
 
-				if (b > a)
+				if (carry != 0u)
+					out_data.push_back(carry);
+			}
+
+			// out = a - b. out may be the same object as a or b, and otherwise reuses its existing storage.
+			template<class block_t>
+			void sub(big_uint<block_t>& out, view_t<block_t> a, view_t<block_t> b)
+			{
+				if (cmp(a, b) < 0)
 					throw std::invalid_argument("cannot subtract larger value from smaller one.");
 
-				debug::die_if(a.data().size() < b.data().size());
+				if (aliases(out, a)) { sub_assign(out, b); return; }
 
-				auto& a_data = a.data();
-				auto const& b_data = b.data();
+				auto const an = a.data().size();
+				auto const bn = b.data().size();
+				auto const out_is_b = aliases(out, b);
 
-				auto borrow = double_block_t{ 0 };
+				// (if out is b, this just adds high zero blocks to b)
+				auto& out_data = out.data();
+				out_data.resize(an);
 
-				// both a and b have data
-				for (auto i = std::size_t{ 0 }; i != b_data.size(); ++i)
-				{
-					borrow = static_cast<double_block_t>(a_data[i]) - static_cast<double_block_t>(b_data[i]) - borrow;
-					a_data[i] = static_cast<block_t>(borrow);
-					borrow = (borrow >> utils::digits<block_t>()) & double_block_t { 1 };
-				}
+				if (out_is_b)
+					blocks::sub_n(out_data.data(), a.data().data(), out_data.data(), an);
+				else
+					blocks::sub(out_data.data(), a.data().data(), an, b.data().data(), bn);
+
+				utils::trim(out);
+			}
+
+			// note: the functions taking a workspace use it for temporary storage (including a copy of the
+			// left operand where the result overwrites it), so don't allocate once the workspace and result are large enough.
+
+			template<class block_t>
+			void sqr_assign(big_uint<block_t>& a, workspace<block_t>& ws = default_workspace<block_t>())
+			{
+				if (a.is_zero()) return;
+				if (a == 1u) return;
+
+				// note: squaring only calculates each cross product once, so needs about half the block multiplications.
 
-				// ran out of data in b, subtract borrow
-				for (auto i = b_data.size(); i != a_data.size() && (borrow != double_block_t{ 0 }); ++i)
 				{
-					borrow = static_cast<double_block_t>(a_data[i]) - borrow;
-					a_data[i] = static_cast<block_t>(borrow);
-					borrow = (borrow >> utils::digits<block_t>()) & double_block_t { 1 };
-				}
+					auto& c_data = a.data();
+					auto const size = c_data.size();
 
-				utils::trim(a);
+					auto frame = typename workspace<block_t>::frame(ws);
+					auto const b = frame.allocate(size);
+					std::copy(c_data.begin(), c_data.end(), b);
+
+					c_data.resize(2u * size);
+
+					blocks::sqr_n(c_data.data(), b, size, ws);
+
+					utils::trim(a);
+				}
 			}
 
 			template<class block_t>
-			void mul_assign(big_uint<block_t>& lhs, big_uint<block_t> const& rhs)
+			void mul_assign(big_uint<block_t>& lhs, view_t<block_t> rhs, workspace<block_t>& ws = default_workspace<block_t>())
 			{
-				using double_block_t = typename big_uint<block_t>::double_block_type;
+				if (aliases(lhs, rhs)) { sqr_assign(lhs, ws); return; }
 
 				if (lhs.is_zero()) return;
 				if (rhs.is_zero()) { lhs.data().clear(); return; }
 
 				if (rhs == 1u) return;
-				if (lhs == 1u) { lhs = rhs; return; }
+				if (lhs == 1u) { lhs.data().assign(rhs.data().begin(), rhs.data().end()); return; }
 
-				// note: long multiplication relies on:
-				// double_block_t holding (max<block_t>() * max<block_t>() + 2 * max<block_t>())
-				// which is exactly the case if digits<double_block_t>() == 2 * digits<block_t>();
+				// note: schoolbook multiplication is used for small operands, karatsuba for large ones.
+				// see ops::thresholds() for the cross-over point.
 
 				{
-					auto b = rhs; // TODO: we only need to copy this if lhs and rhs refer to the same object
-					auto a = std::move(lhs);
-					auto& c = lhs;
+					auto& c_data = lhs.data(); // rhs is a different number, so is unaffected
+					auto const b_data = rhs.data();
+					auto const size = c_data.size();
 
-					auto const& a_data = a.data();
-					auto const& b_data = b.data();
-					auto& c_data = c.data();
+					auto frame = typename workspace<block_t>::frame(ws);
+					auto const a = frame.allocate(size);
+					std::copy(c_data.begin(), c_data.end(), a);
 
-					c_data.resize(a_data.size() + b_data.size());
+					c_data.resize(size + b_data.size());
 
-					for (auto i = std::size_t{ 0 }; i != a_data.size(); ++i)
-					{
-						auto carry = double_block_t{ 0 };
-
-						for (auto j = std::size_t{ 0 }; j != b_data.size(); ++j)
-						{
-							carry += static_cast<double_block_t>(a_data[i]) * static_cast<double_block_t>(b_data[j]);
-							carry += c_data[i + j];
-							c_data[i + j] = static_cast<block_t>(carry);
-							carry >>= utils::digits<block_t>();
-						}
-
-						// c_data[i + b_data.size()] is always zero
-						if (carry)
-							c_data[i + b_data.size()] = static_cast<block_t>(carry);
-					}
+					blocks::mul(c_data.data(), a, size, b_data.data(), b_data.size(), ws);
 
-					utils::trim(c);
+					utils::trim(lhs);
 				}
 			}
 
-			template<class block_t>
-			void divmod(big_uint<block_t>& quotient, big_uint<block_t>& remainder, big_uint<block_t> dividend, big_uint<block_t> divisor)
+			template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			void mul_assign(big_uint<block_t>& a, uint_t n)
 			{
-				using double_block_t = typename big_uint<block_t>::double_block_type;
+				auto const b = utils::to_blocks<block_t>(n);
 
-				quotient.data().clear();
-				remainder.data().clear();
+				if (b.size == 0u) { a.data().clear(); return; }
 
-				debug::die_if(divisor.is_zero());
-				debug::die_if(dividend < divisor);
-				debug::die_if(dividend == divisor);
-				debug::die_if(dividend.data().size() == 1u && divisor.data().size() == 1u);
+				auto& a_data = a.data();
+				auto const a_size = a_data.size();
 
-				auto const get_num_leading_zeros = [] (block_t x)
+				if (b.size == 1u)
 				{
-					debug::die_if(x == 0);
+					auto const carry = blocks::mul_1(a_data.data(), a_data.data(), a_size, b.blocks[0]);
 
-					auto count = std::size_t{ 0 };
-
-					while (x != 0)
-					{
-						++count;
-						x >>= 1;
-					}
+					if (carry != 0u)
+						a_data.push_back(carry);
 
-					return utils::digits<block_t>() - count;
-				};
+					return;
+				}
 
-				auto const promote = [] (double_block_t b) { return b << utils::digits<block_t>(); };
-				auto const demote = [] (double_block_t b) { return b >> utils::digits<block_t>(); };
-				auto const checked_sub = [] (block_t& out, block_t a, block_t b) { return ((out = a - b) > a); };
+				// multiply in place, from the top block of a down (so each block of a is read before the product overwrites it)
+				a_data.resize(a_size + b.size);
 
+				for (auto i = a_size; i != 0u; )
 				{
-					auto& d = divisor;
-					auto& n = remainder;
-					remainder = std::move(dividend);
-					auto& q = quotient;
+					--i;
 
-					q.data().resize(n.data().size() - d.data().size() + 1);
+					auto const x = a_data[i];
+					a_data[i] = block_t{ 0 };
 
-					// single digit divisor
-					if (d.data().size() == 1)
-					{
-						auto k = double_block_t{ 0 };
-						auto const v = d.data()[0];
+					auto const carry = blocks::addmul_1(a_data.data() + i, b.blocks.data(), b.size, x);
+					blocks::add_1(a_data.data() + i + b.size, a_data.data() + i + b.size, a_size - i, carry);
+				}
 
-						for (auto i = n.data().size(); i != 0; --i)
-						{
-							auto const index = i - 1;
-							k = (k << utils::digits<block_t>()) + n.data()[index];
-							q.data()[index] = static_cast<block_t>(k / v);
-							k -= static_cast<double_block_t>(q.data()[index]) * v;
-						}
+				utils::trim(a);
+			}
 
-						n.data().clear();
+			// out = a * a. out may be the same object as a, and otherwise reuses its existing storage.
+			template<class block_t>
+			void sqr(big_uint<block_t>& out, view_t<block_t> a, workspace<block_t>& ws = default_workspace<block_t>())
+			{
+				if (aliases(out, a)) { sqr_assign(out, ws); return; }
 
-						if (k != 0)
-							n.data().push_back(static_cast<block_t>(k));
+				auto const a_data = a.data();
+				auto& out_data = out.data();
 
-						utils::trim(q);
+				out_data.resize(2u * a_data.size());
 
-						return;
-					}
+				if (!a_data.empty())
+					blocks::sqr_n(out_data.data(), a_data.data(), a_data.size(), ws);
 
-					auto const b = double_block_t{ 1 } << utils::digits<block_t>();
-					auto const ns = n.data().size(); // m
-					auto const ds = d.data().size(); // n
+				utils::trim(out);
+			}
 
-					auto shift = get_num_leading_zeros(d.data().back());
-					d <<= shift;
-					n <<= shift;
+			// out = a * b. out may be the same object as a or b, and reuses its existing storage.
+			template<class block_t>
+			void mul(big_uint<block_t>& out, view_t<block_t> a, view_t<block_t> b, workspace<block_t>& ws = default_workspace<block_t>())
+			{
+				if (a.data().data() == b.data().data() && a.data().size() == b.data().size()) { sqr(out, a, ws); return; }
+				if (aliases(out, a)) { mul_assign(out, b, ws); return; }
+				if (aliases(out, b)) { mul_assign(out, a, ws); return; }
 
-					if (n.data().size() == ns)
-						n.data().push_back(block_t{ 0 });
+				auto const a_data = a.data();
+				auto const b_data = b.data();
+				auto& out_data = out.data();
 
-					for (auto i_outer = (ns - ds) + 1; i_outer != 0; --i_outer)
-					{
-						auto const j = i_outer - 1;
-
-						// take the top two blocks of n, divide by top block of d, calc remainder
-						auto v = d.data()[ds - 1];
-						auto n_block = static_cast<double_block_t>(promote(n.data()[j + ds]) | n.data()[j + ds - 1]);
-						auto qhat = static_cast<double_block_t>(n_block / v);
-						auto rhat = static_cast<double_block_t>(n_block - qhat * v);
-
-						// q is too big or (looking at next block) remainder is smaller than what will be taken away
-						while (qhat >= b || (qhat * d.data()[ds - 2]) > (promote(rhat) + n.data()[j + ds - 2]))
-						{
-							qhat -= 1; rhat += v;
-							if (rhat >= b) break;
-						}
-
-						// qhat is now correct, or 1 too high (extremely rare)
-
-						// multiply divisor by qhat and subtract from n
-						auto underflow = false;
-						{
-							auto k = double_block_t{ 0 };
-							for (auto i = std::size_t{ 0 }; i != ds; ++i)
-							{
-								auto const p = static_cast<double_block_t>(qhat * d.data()[i]);
-								auto const t = static_cast<double_block_t>(n.data()[i + j] - k - static_cast<block_t>(p));
-								n.data()[i + j] = static_cast<block_t>(t);
-								k = static_cast<double_block_t>(demote(p) - (static_cast<std::make_signed_t<double_block_t>>(t) >> utils::digits<block_t>()));
-							}
-
-							if (k != 0)
-								underflow |= checked_sub(n.data()[j + ds], n.data()[j + ds], static_cast<block_t>(k));
-						}
-
-						// set quotient
-						q.data()[j] = static_cast<block_t>(qhat);
-
-						// underflow! (qhat was 1 too high)
-						// decrement q and add back one divisor to the remainder
-						if (underflow)
-						{
-							q.data()[j] = q.data()[j] - 1;
-
-							auto k = double_block_t{ 0 };
-							for (auto i = std::size_t{ 0 }; i != ds; ++i)
-							{
-								auto const t = double_block_t{ n.data()[i + j] } + d.data()[i] + k;
-								n.data()[i + j] = static_cast<block_t>(t);
-								k = static_cast<double_block_t>(t >> utils::digits<block_t>());
-							}
-
-							n.data()[j + ds] += static_cast<block_t>(k);
-						}
-					}
+				if (a_data.empty() || b_data.empty())
+				{
+					out_data.clear();
+					return;
+				}
 
-					utils::trim(q);
+				out_data.resize(a_data.size() + b_data.size());
 
-					// shift remainder back
-					utils::trim(n);
-					n >>= shift;
-				}
+				blocks::mul(out_data.data(), a_data.data(), a_data.size(), b_data.data(), b_data.size(), ws);
+
+				utils::trim(out);
 			}
 
+			// quotient = dividend / divisor, remainder = dividend % divisor. quotient and remainder must be different objects, but either may be
+			// the same object as the dividend or divisor. the normalized operands are stored in ws.
 			template<class block_t>
-			void div_assign(big_uint<block_t>& lhs, big_uint<block_t> const& rhs)
+			void divmod(big_uint<block_t>& quotient, big_uint<block_t>& remainder, view_t<block_t> dividend, view_t<block_t> divisor, workspace<block_t>& ws = default_workspace<block_t>())
 			{
-				using double_block_t = typename big_uint<block_t>::double_block_type;
+				debug::die_if(&quotient == &remainder);
 
-				if (rhs.is_zero())
+				if (divisor.is_zero())
 					throw std::invalid_argument("divisor cannot be zero.");
 
-				if (lhs < rhs) { lhs.data().clear(); return; }
-				if (lhs == rhs) { lhs.data().clear(); lhs.data().push_back(1); return; }
-
-				if (lhs.data().size() == 1u && rhs.data().size() == 1u)
+				if (cmp(dividend, divisor) < 0)
 				{
-					lhs = static_cast<block_t>(lhs.data()[0] / rhs.data()[0]);
+					if (!aliases(remainder, dividend))
+						remainder.data().assign(dividend.data().begin(), dividend.data().end());
+
+					quotient.data().clear();
 					return;
 				}
 
+				auto const nn = dividend.data().size();
+				auto const ds = divisor.data().size();
+				auto const qn = nn - ds + 1u;
+
+				auto frame = typename workspace<block_t>::frame(ws);
+				auto d = divisor.data().data();
+
+				// (growing the quotient could reallocate the divisor's blocks)
+				if (aliases(quotient, divisor))
 				{
-					auto q = big_uint<block_t>();
-					auto r = big_uint<block_t>();
-					divmod(q, r, lhs, rhs);
-					lhs = std::move(q);
+					auto const copy = frame.allocate(ds);
+					std::copy(divisor.data().begin(), divisor.data().end(), copy);
+					d = copy;
 				}
+
+				// the outputs are only grown here (an output that's the same as an operand is already large enough), and shrunk afterwards.
+				// tdiv_qr reads the operands before writing, so the outputs may share their blocks.
+				if (quotient.data().size() < qn)
+					quotient.data().resize(qn);
+
+				if (remainder.data().size() < ds)
+					remainder.data().resize(ds);
+
+				blocks::tdiv_qr(quotient.data().data(), remainder.data().data(), dividend.data().data(), nn, d, ds, ws);
+
+				quotient.data().resize(qn);
+				remainder.data().resize(ds);
+
+				utils::trim(quotient);
+				utils::trim(remainder);
 			}
 
 			template<class block_t>
-			void mod_assign(big_uint<block_t>& lhs, big_uint<block_t> const& rhs)
+			void div_assign(big_uint<block_t>& lhs, view_t<block_t> rhs, workspace<block_t>& ws = default_workspace<block_t>())
 			{
-				using double_block_t = typename big_uint<block_t>::double_block_type;
+				if (rhs.is_zero())
+					throw std::invalid_argument("divisor cannot be zero.");
+
+				auto const c = cmp(big_uint_view<block_t>(lhs), rhs);
+				if (c < 0) { lhs.data().clear(); return; }
+				if (c == 0) { lhs.data().clear(); lhs.data().push_back(1); return; }
+
+				auto& n = lhs.data();
+				auto const d = rhs.data();
+				auto const qn = n.size() - d.size() + 1u;
 
+				// (the quotient is written over the dividend)
+				auto frame = typename workspace<block_t>::frame(ws);
+				auto const r = frame.allocate(d.size());
+
+				blocks::tdiv_qr(n.data(), r, n.data(), n.size(), d.data(), d.size(), ws);
+
+				n.resize(qn);
+				utils::trim(lhs);
+			}
+
+			template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			void div_assign(big_uint<block_t>& lhs, uint_t n)
+			{
+				auto const d = utils::to_blocks<block_t>(n);
+
+				if (d.size == 0u)
+					throw std::invalid_argument("divisor cannot be zero.");
+
+				// (divisors wider than a block use the general division)
+				if (d.size != 1u)
+				{
+					div_assign(lhs, big_uint<block_t>(n, lhs.get_allocator()));
+					return;
+				}
+
+				blocks::divrem_1(lhs.data().data(), lhs.data().data(), lhs.data().size(), d.blocks[0]);
+				utils::trim(lhs);
+			}
+
+			// lhs = lhs % rhs, in place, without storing the quotient (except for divisions large enough to use burnikel-ziegler).
+			// the normalized operands (and quotient) are stored in ws.
+			template<class block_t>
+			void mod_assign(big_uint<block_t>& lhs, view_t<block_t> rhs, workspace<block_t>& ws = default_workspace<block_t>())
+			{
 				if (rhs.is_zero())
 					throw std::invalid_argument("divisor cannot be zero.");
 
-				if (lhs < rhs) { return; }
-				if (lhs == rhs) { lhs.data().clear(); return; }
+				auto const c = cmp(big_uint_view<block_t>(lhs), rhs);
+				if (c < 0) { return; }
+				if (c == 0) { lhs.data().clear(); return; }
+
+				auto& n = lhs.data();
+				auto const d = rhs.data();
+
+				blocks::tdiv_qr<block_t>(nullptr, n.data(), n.data(), n.size(), d.data(), d.size(), ws);
 
-				if (lhs.data().size() == 1u && rhs.data().size() == 1u)
+				n.resize(d.size());
+				utils::trim(lhs);
+			}
+
+			// out = a % b. out may be the same object as a or b, and otherwise reuses its existing storage.
+			template<class block_t>
+			void mod(big_uint<block_t>& out, view_t<block_t> a, view_t<block_t> b, workspace<block_t>& ws = default_workspace<block_t>())
+			{
+				if (aliases(out, a)) { mod_assign(out, b, ws); return; }
+
+				if (b.is_zero())
+					throw std::invalid_argument("divisor cannot be zero.");
+
+				if (cmp(a, b) < 0)
 				{
-					lhs = static_cast<block_t>(lhs.data()[0] % rhs.data()[0]);
-					utils::trim(lhs);
+					out.data().assign(a.data().begin(), a.data().end());
 					return;
 				}
 
+				auto const ds = b.data().size();
+
+				// (if out is b, it's already large enough, and tdiv_qr reads b before writing the remainder over it)
+				if (out.data().size() < ds)
+					out.data().resize(ds);
+
+				blocks::tdiv_qr<block_t>(nullptr, out.data().data(), a.data().data(), a.data().size(), b.data().data(), ds, ws);
+
+				out.data().resize(ds);
+				utils::trim(out);
+			}
+
+			template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			void mod_assign(big_uint<block_t>& lhs, uint_t n)
+			{
+				auto const d = utils::to_blocks<block_t>(n);
+
+				if (d.size == 0u)
+					throw std::invalid_argument("divisor cannot be zero.");
+
+				// (divisors wider than a block use the general division)
+				if (d.size != 1u)
 				{
-					auto q = big_uint<block_t>();
-					auto r = big_uint<block_t>();
-					divmod(q, r, lhs, rhs);
-					lhs = std::move(r);
+					mod_assign(lhs, big_uint<block_t>(n, lhs.get_allocator()));
+					return;
 				}
+
+				auto const r = blocks::mod_1(lhs.data().data(), lhs.data().size(), d.blocks[0]);
+
+				lhs.data().clear();
+
+				if (r != 0u)
+					lhs.data().push_back(r);
+			}
+
+			// returns a % n.
+			template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			uint_t mod(big_uint_view<block_t> a, uint_t n)
+			{
+				auto const d = utils::to_blocks<block_t>(n);
+
+				if (d.size == 0u)
+					throw std::invalid_argument("divisor cannot be zero.");
+
+				if constexpr (d.capacity != 1u)
+				{
+					// (divisors wider than a block use the general division)
+					if (d.size != 1u)
+					{
+						auto r = big_uint<block_t>(a);
+						mod_assign(r, big_uint<block_t>(n, r.get_allocator()));
+						return r.template to_uint<uint_t>();
+					}
+				}
+
+				return static_cast<uint_t>(blocks::mod_1(a.data().data(), a.data().size(), d.blocks[0]));
+			}
+
+			template<class block_t, class uint_t, typename = utils::enable_if_uint_t<uint_t>>
+			uint_t mod(big_uint<block_t> const& a, uint_t n)
+			{
+				return mod(big_uint_view<block_t>(a), n);
 			}
 
 			template<class block_t>
@@ -1,33 +1,190 @@
 
+#include "rsa_math__barrett.h"
 #include "rsa_math__big_uint.h"
+#include "rsa_math__expressions.h"
+#include "rsa_math__fixed_montgomery.h"
+#include "rsa_math__fixed_uint.h"
+#include "rsa_math__mod_pow.h"
+#include "rsa_math__montgomery.h"
 #include "rsa_math__primes.h"
 
 #include <benchmark/benchmark.h>
 
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <memory_resource>
+#include <new>
 #include <random>
+#include <vector>
 
-//static void BM_RSA_division(benchmark::State& state)
-//{
-//	auto rng = std::mt19937_64();
-//	auto a_dist = std::uniform_int_distribution<std::uint16_t>(0u, rsa::math::meta::max<std::uint16_t>());
-//
-//	auto a = rsa::math::big_uint_16();
-//	auto a_blocks = std::size_t(state.range(0));
-//	a.data().resize(a_blocks);
-//
-//	for (auto i = 0u; i != a_blocks; ++i)
-//		a.data()[i] = a_dist(rng);
-//
-//	auto b_dist = std::uniform_int_distribution<std::uint16_t>(0u, rsa::math::meta::max<std::uint16_t>());
-//	auto b = rsa::math::big_uint_16(b_dist(rng));
-//
-//	for (auto _ : state)
-//	{
-//		a / b;
-//	}
-//}
-//
-//BENCHMARK(BM_RSA_division)->Range(8u, 16384u)->Complexity()->Unit(benchmark::kMicrosecond);
+// all heap allocations are counted, so benchmarks can report allocations per iteration.
+namespace
+{
+	auto allocation_count = std::size_t{ 0 };
+}
+
+void* operator new(std::size_t size)
+{
+	++allocation_count;
+
+	if (auto p = std::malloc(size != 0u ? size : 1u))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+// (std::pmr::new_delete_resource may use the aligned versions)
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	++allocation_count;
+
+	auto const a = static_cast<std::size_t>(alignment);
+
+#if defined(_MSC_VER)
+	if (auto p = _aligned_malloc(size != 0u ? size : 1u, a))
+		return p;
+#else
+	if (auto p = std::aligned_alloc(a, (size + a - 1u) / a * a + (size == 0u ? a : 0u)))
+		return p;
+#endif
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+#if defined(_MSC_VER)
+	_aligned_free(p);
+#else
+	std::free(p);
+#endif
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(p, alignment);
+}
+
+static void BM_RSA_division(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto a_dist = std::uniform_int_distribution<std::uint16_t>(0u, rsa::math::utils::max<std::uint16_t>());
+
+	auto a = rsa::math::big_uint_16();
+	auto a_blocks = std::size_t(state.range(0));
+	a.data().resize(a_blocks);
+
+	for (auto i = 0u; i != a_blocks; ++i)
+		a.data()[i] = a_dist(rng);
+
+	a.data().back() |= 1u;
+
+	auto b_dist = std::uniform_int_distribution<std::uint16_t>(1u, rsa::math::utils::max<std::uint16_t>());
+	auto b = rsa::math::big_uint_16(b_dist(rng));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(a / b);
+
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_division)->RangeMultiplier(4u)->Range(8u, 16384u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// 2n by n block division (e.g. reducing a product modulo an n block number)
+static void run_division_32(benchmark::State& state, std::size_t burnikel_ziegler_threshold)
+{
+	auto rng = std::mt19937_64();
+	auto const a = rsa::math::generate_random_bits<std::uint32_t>(rng, 2u * std::size_t(state.range(0)));
+	auto const b = rsa::math::generate_random_bits<std::uint32_t>(rng, std::size_t(state.range(0))) | (rsa::math::big_uint_32(1u) <<= std::size_t(state.range(0) - 1));
+
+	auto const old_thresholds = rsa::math::ops::thresholds();
+	rsa::math::ops::thresholds().burnikel_ziegler = burnikel_ziegler_threshold;
+
+	for (auto _ : state)
+	{
+		auto q = rsa::math::big_uint_32(); auto r = rsa::math::big_uint_32();
+		rsa::math::ops::divmod_test(q, r, a, b);
+		benchmark::DoNotOptimize(q);
+		benchmark::DoNotOptimize(r);
+	}
+
+	rsa::math::ops::thresholds() = old_thresholds;
+	state.SetComplexityN(state.range(0));
+}
+
+static void BM_RSA_division_basecase_32(benchmark::State& state)
+{
+	run_division_32(state, std::numeric_limits<std::size_t>::max());
+}
+
+BENCHMARK(BM_RSA_division_basecase_32)->RangeMultiplier(2u)->Range(256u, 262144u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_RSA_division_burnikel_ziegler_32(benchmark::State& state)
+{
+	run_division_32(state, RSA_MATH_BURNIKEL_ZIEGLER_THRESHOLD);
+}
+
+BENCHMARK(BM_RSA_division_burnikel_ziegler_32)->RangeMultiplier(2u)->Range(256u, 262144u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// the block kernels alone (no big_uint storage, trimming or aliasing checks)
+static void BM_RSA_blocks_addmul_1_32(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto dist = std::uniform_int_distribution<std::uint32_t>(0u, rsa::math::utils::max<std::uint32_t>());
+
+	auto a = std::vector<std::uint32_t>(std::size_t(state.range(0)));
+	auto r = std::vector<std::uint32_t>(a.size());
+	std::generate(a.begin(), a.end(), [&] () { return dist(rng); });
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(rsa::math::ops::blocks::addmul_1(r.data(), a.data(), a.size(), 0x9abcdef1u));
+		benchmark::ClobberMemory();
+	}
+
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_blocks_addmul_1_32)->RangeMultiplier(4u)->Range(16u, 4096u)->Complexity()->Unit(benchmark::kNanosecond);
+
+// 2n by n block division
+static void BM_RSA_blocks_tdiv_qr_32(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto dist = std::uniform_int_distribution<std::uint32_t>(0u, rsa::math::utils::max<std::uint32_t>());
+
+	auto const size = std::size_t(state.range(0));
+	auto n = std::vector<std::uint32_t>(2u * size);
+	auto d = std::vector<std::uint32_t>(size);
+	std::generate(n.begin(), n.end(), [&] () { return dist(rng); });
+	std::generate(d.begin(), d.end(), [&] () { return dist(rng); });
+	d.back() |= 1u;
+
+	auto q = std::vector<std::uint32_t>(size + 1u);
+	auto r = std::vector<std::uint32_t>(size);
+	auto ws = rsa::math::workspace<std::uint32_t>();
+
+	for (auto _ : state)
+	{
+		rsa::math::ops::blocks::tdiv_qr(q.data(), r.data(), n.data(), n.size(), d.data(), d.size(), ws);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_blocks_tdiv_qr_32)->RangeMultiplier(4u)->Range(16u, 4096u)->Complexity()->Unit(benchmark::kMicrosecond);
 
 //static void BM_RSA_generate_prime(benchmark::State& state)
 //{
@@ -38,64 +195,761 @@
 //}
 //
 //BENCHMARK(BM_RSA_generate_prime)->RangeMultiplier(2u)->Range(2u, 64u)->Complexity()->Unit(benchmark::kMicrosecond);
-//
-//static void BM_RSA_is_prime_rm_32(benchmark::State& state)
-//{
-//	auto n_rng = std::mt19937_64();
-//	auto ns = std::vector<rsa::math::big_uint_32>();
-//	for (auto i = 0u; i != 50u; ++i)
-//		ns.push_back(rsa::math::generate_random_bits<std::uint32_t>(n_rng, std::size_t(state.range(0))));
-//
-//	auto k = 20u;
-//
-//	auto rng = std::mt19937_64();
-//	for (auto _ : state)
-//		for (auto const& n : ns)
-//			benchmark::DoNotOptimize(rsa::math::is_prime_rm(n, rng, k));
-//}
-//
-//BENCHMARK(BM_RSA_is_prime_rm_32)->RangeMultiplier(2u)->Range(2u, 2048u)->Complexity()->Unit(benchmark::kMicrosecond);
-//
-//static void BM_RSA_is_prime_rm_64(benchmark::State& state)
-//{
-//	auto n_rng = std::mt19937_64();
-//	auto ns = std::vector<rsa::math::big_uint_64>();
-//	for (auto i = 0u; i != 50u; ++i)
-//		ns.push_back(rsa::math::generate_random_bits<std::uint64_t>(n_rng, std::size_t(state.range(0))));
-//
-//	auto k = 20u;
-//
-//	auto rng = std::mt19937_64();
-//	for (auto _ : state)
-//		for (auto const& n : ns)
-//			benchmark::DoNotOptimize(rsa::math::is_prime_rm(n, rng, k));
-//}
-//
-//BENCHMARK(BM_RSA_is_prime_rm_64)->RangeMultiplier(2u)->Range(2u, 2048u)->Complexity()->Unit(benchmark::kMicrosecond);
 
-//static void BM_RSA_is_prime(benchmark::State& state)
-//{
-//	auto n_rng = std::mt19937_64();
-//	auto ns = std::vector<rsa::math::big_uint_32>();
-//	for (auto i = 0u; i != 50u; ++i)
-//		ns.push_back(rsa::math::generate_random_bits<std::uint32_t>(n_rng, state.range(0)));
-//
-//	for (auto _ : state)
-//		for (auto const& n : ns)
-//			benchmark::DoNotOptimize(rsa::math::is_prime(n));
-//}
-//
-//BENCHMARK(BM_RSA_is_prime)->RangeMultiplier(2u)->Range(2u, 48u)->Complexity()->Unit(benchmark::kMicrosecond);
+static void BM_RSA_is_prime_rm_32(benchmark::State& state)
+{
+	auto n_rng = std::mt19937_64();
+	auto ns = std::vector<rsa::math::big_uint_32>();
+	for (auto i = 0u; i != 50u; ++i)
+		ns.push_back(rsa::math::generate_random_bits<std::uint32_t>(n_rng, std::size_t(state.range(0))));
+
+	auto k = 20u;
+
+	auto const allocations_before = allocation_count;
+
+	auto rng = std::mt19937_64();
+	for (auto _ : state)
+		for (auto const& n : ns)
+			benchmark::DoNotOptimize(rsa::math::is_prime_rm(n, rng, k));
+
+	// (per number tested)
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before) / double(ns.size()), benchmark::Counter::kAvgIterations);
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_is_prime_rm_32)->RangeMultiplier(2u)->Range(2u, 2048u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// as above, without the trial division, with fixed bases (the first 20 primes) and the montgomery context shared by the rounds
+static void BM_RSA_is_strong_probable_prime_32(benchmark::State& state)
+{
+	auto n_rng = std::mt19937_64();
+	auto ns = std::vector<rsa::math::big_uint_32>();
+	for (auto i = 0u; i != 50u; ++i)
+		ns.push_back(rsa::math::generate_random_bits<std::uint32_t>(n_rng, std::size_t(state.range(0))));
+
+	auto const bases = std::vector<std::uint32_t>(rsa::math::first_100_primes.begin(), rsa::math::first_100_primes.begin() + 20);
+
+	auto const allocations_before = allocation_count;
+
+	for (auto _ : state)
+		for (auto const& n : ns)
+			benchmark::DoNotOptimize(rsa::math::is_strong_probable_prime(n, bases));
+
+	// (per number tested)
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before) / double(ns.size()), benchmark::Counter::kAvgIterations);
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_is_strong_probable_prime_32)->RangeMultiplier(2u)->Range(2u, 2048u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// the cost of rejecting a (probably composite) prime candidate with one miller-rabin round (including the setup), per candidate
+static void run_miller_rabin_round_32(benchmark::State& state, bool base_2)
+{
+	auto n_rng = std::mt19937_64();
+	auto ns = std::vector<rsa::math::big_uint_32>();
+	for (auto i = 0u; i != 20u; ++i)
+	{
+		ns.push_back(rsa::math::generate_random_bits<std::uint32_t>(n_rng, std::size_t(state.range(0))));
+		ns.back().set_bit(0u, true);
+		ns.back().set_bit(std::size_t(state.range(0)) - 1u, true);
+	}
+
+	auto const two = rsa::math::big_uint_32(2u);
+
+	for (auto _ : state)
+	{
+		for (auto const& n : ns)
+		{
+			auto const rounds = rsa::math::miller_rabin<std::uint32_t>(n);
+			benchmark::DoNotOptimize(base_2 ? rounds.test_base_2() : rounds.test(two));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(ns.size()));
+	state.SetComplexityN(state.range(0));
+}
+
+static void BM_RSA_miller_rabin_round_32(benchmark::State& state)
+{
+	run_miller_rabin_round_32(state, false);
+}
+
+BENCHMARK(BM_RSA_miller_rabin_round_32)->RangeMultiplier(2u)->Range(256u, 4096u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// as above, with test_base_2 (doubling instead of multiplying by the base)
+static void BM_RSA_miller_rabin_round_base_2_32(benchmark::State& state)
+{
+	run_miller_rabin_round_32(state, true);
+}
+
+BENCHMARK(BM_RSA_miller_rabin_round_base_2_32)->RangeMultiplier(2u)->Range(256u, 4096u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// the trial division in is_prime_rm, with the number of primes (arg 1) changed for each size (arg 0)
+// of random odd number. the fastest count for each size is a good value for trial_division_primes().
+static void BM_RSA_is_prime_rm_trial_division_32(benchmark::State& state)
+{
+	auto n_rng = std::mt19937_64();
+	auto ns = std::vector<rsa::math::big_uint_32>();
+	for (auto i = 0u; i != 50u; ++i)
+	{
+		ns.push_back(rsa::math::generate_random_bits<std::uint32_t>(n_rng, std::size_t(state.range(0))));
+		ns.back().set_bit(0u, true);
+		ns.back().set_bit(std::size_t(state.range(0)) - 1u, true);
+	}
+
+	auto k = 20u;
+
+	auto const scoped_primes = rsa::math::scoped_trial_division_primes(std::size_t(state.range(1)));
+
+	auto rng = std::mt19937_64();
+	for (auto _ : state)
+		for (auto const& n : ns)
+			benchmark::DoNotOptimize(rsa::math::is_prime_rm(n, rng, k));
+}
+
+static void trial_division_args(benchmark::internal::Benchmark* b)
+{
+	for (auto const bits : { 256, 512, 1024, 2048 })
+		for (auto const primes : { 25, 100, 300, 1000, 3000, 6543 })
+			b->Args({ bits, primes });
+}
+
+BENCHMARK(BM_RSA_is_prime_rm_trial_division_32)->Apply(trial_division_args)->Unit(benchmark::kMillisecond);
+
+// the residues of a number modulo the first 100 primes, one prime at a time (as is_prime_rm used to)
+static void BM_RSA_trial_division_mod_32(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto const n = rsa::math::generate_random_bits<std::uint32_t>(rng, std::size_t(state.range(0))) | 1u;
+
+	for (auto _ : state)
+		for (auto const p : rsa::math::first_100_primes)
+			benchmark::DoNotOptimize(rsa::math::ops::mod(n, p));
+
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_trial_division_mod_32)->RangeMultiplier(4u)->Range(128u, 8192u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// as above, with find_small_factor (several primes per division, in batches)
+static void BM_RSA_find_small_factor_32(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto const n = rsa::math::generate_random_bits<std::uint32_t>(rng, std::size_t(state.range(0))) | 1u;
+
+	// (n probably has a small factor, so use a number without one)
+	auto m = n;
+	while (rsa::math::find_small_factor<std::uint32_t>(m, 100u) != 0u)
+		m += 2u;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(rsa::math::find_small_factor<std::uint32_t>(m, 100u));
+
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_find_small_factor_32)->RangeMultiplier(4u)->Range(128u, 8192u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+#if defined(__SIZEOF_INT128__)
+
+static void BM_RSA_is_prime_rm_64(benchmark::State& state)
+{
+	auto n_rng = std::mt19937_64();
+	auto ns = std::vector<rsa::math::big_uint_64>();
+	for (auto i = 0u; i != 50u; ++i)
+		ns.push_back(rsa::math::generate_random_bits<std::uint64_t>(n_rng, std::size_t(state.range(0))));
+
+	auto k = 20u;
+
+	auto rng = std::mt19937_64();
+	for (auto _ : state)
+		for (auto const& n : ns)
+			benchmark::DoNotOptimize(rsa::math::is_prime_rm(n, rng, k));
+
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_is_prime_rm_64)->RangeMultiplier(2u)->Range(2u, 2048u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+#endif
+
+// trial division (mostly operations on small numbers)
+static void BM_RSA_is_prime(benchmark::State& state)
+{
+	auto n_rng = std::mt19937_64();
+	auto ns = std::vector<rsa::math::big_uint_32>();
+	for (auto i = 0u; i != 50u; ++i)
+		ns.push_back(rsa::math::generate_random_bits<std::uint32_t>(n_rng, std::size_t(state.range(0))));
+
+	auto const allocations_before = allocation_count;
+
+	for (auto _ : state)
+		for (auto const& n : ns)
+			benchmark::DoNotOptimize(rsa::math::is_prime(n));
+
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_is_prime)->RangeMultiplier(2u)->Range(8u, 32u)->Unit(benchmark::kMicrosecond);
+
+static void run_multiplication_32(benchmark::State& state, rsa::math::ops::thresholds_type thresholds)
+{
+	auto rng = std::mt19937_64();
+	auto const num_bits = std::size_t(state.range(0)) * 32u;
+	auto const a = rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits);
+	auto const b = rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits);
+
+	auto const old_thresholds = rsa::math::ops::thresholds();
+	rsa::math::ops::thresholds() = thresholds;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(a * b);
+
+	rsa::math::ops::thresholds() = old_thresholds;
+	state.SetComplexityN(state.range(0));
+}
+
+static void BM_RSA_multiplication_schoolbook_32(benchmark::State& state)
+{
+	auto const never = std::numeric_limits<std::size_t>::max();
+	run_multiplication_32(state, { never, never, never });
+}
+
+BENCHMARK(BM_RSA_multiplication_schoolbook_32)->RangeMultiplier(2u)->Range(8u, 4096u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_RSA_multiplication_karatsuba_32(benchmark::State& state)
+{
+	auto const never = std::numeric_limits<std::size_t>::max();
+	run_multiplication_32(state, { RSA_MATH_KARATSUBA_THRESHOLD, never, never });
+}
+
+BENCHMARK(BM_RSA_multiplication_karatsuba_32)->RangeMultiplier(2u)->Range(8u, 4096u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_RSA_multiplication_toom3_32(benchmark::State& state)
+{
+	auto const never = std::numeric_limits<std::size_t>::max();
+	run_multiplication_32(state, { RSA_MATH_KARATSUBA_THRESHOLD, RSA_MATH_TOOM3_THRESHOLD, never });
+}
+
+BENCHMARK(BM_RSA_multiplication_toom3_32)->RangeMultiplier(2u)->Range(8u, 65536u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_RSA_multiplication_ntt_32(benchmark::State& state)
+{
+	run_multiplication_32(state, { RSA_MATH_KARATSUBA_THRESHOLD, RSA_MATH_TOOM3_THRESHOLD, 0u });
+}
+
+BENCHMARK(BM_RSA_multiplication_ntt_32)->RangeMultiplier(2u)->Range(8u, 65536u)->Complexity(benchmark::oNLogN)->Unit(benchmark::kMicrosecond);
+
+// same number of bits, with different block sizes
+
+template<class block_t>
+static void run_multiplication_bits(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto const num_bits = std::size_t(state.range(0));
+	auto const a = rsa::math::generate_random_bits<block_t>(rng, num_bits);
+	auto const b = rsa::math::generate_random_bits<block_t>(rng, num_bits);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(a * b);
+
+	state.SetComplexityN(state.range(0));
+}
+
+static void BM_RSA_multiplication_bits_32(benchmark::State& state)
+{
+	run_multiplication_bits<std::uint32_t>(state);
+}
+
+BENCHMARK(BM_RSA_multiplication_bits_32)->RangeMultiplier(4u)->Range(256u, 262144u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+#if defined(__SIZEOF_INT128__)
+
+static void BM_RSA_multiplication_bits_64(benchmark::State& state)
+{
+	run_multiplication_bits<std::uint64_t>(state);
+}
+
+BENCHMARK(BM_RSA_multiplication_bits_64)->RangeMultiplier(4u)->Range(256u, 262144u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+#endif
+
+static void BM_RSA_square_32(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto const num_bits = std::size_t(state.range(0)) * 32u;
+	auto const a = rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits);
+
+	// compare with BM_RSA_square_as_multiplication_32
+
+	for (auto _ : state)
+	{
+		auto c = a;
+		benchmark::DoNotOptimize(rsa::math::square(c));
+	}
+
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_square_32)->RangeMultiplier(2u)->Range(8u, 65536u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_RSA_square_as_multiplication_32(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto const num_bits = std::size_t(state.range(0)) * 32u;
+	auto const a = rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits);
+	auto const b = a;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(a * b);
+
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_square_as_multiplication_32)->RangeMultiplier(2u)->Range(8u, 65536u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// modular multiplication, by modulus size in bits (compare with BM_RSA_montgomery_mul_32)
+
+static void BM_RSA_mod_mul_32(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto const num_bits = std::size_t(state.range(0));
+
+	auto n = rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits);
+	n.set_bit(0u, true);
+
+	auto const a = rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits) % n;
+	auto const b = rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits) % n;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize((a * b) % n);
+
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_mod_mul_32)->RangeMultiplier(2u)->Range(256u, 8192u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_RSA_montgomery_mul_32(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto const num_bits = std::size_t(state.range(0));
+
+	auto n = rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits);
+	n.set_bit(0u, true);
+
+	auto const context = rsa::math::montgomery_context<std::uint32_t>(n);
+	auto const a = context.to_montgomery(rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits));
+	auto const b = context.to_montgomery(rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(context.mul(a, b));
+
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_montgomery_mul_32)->RangeMultiplier(2u)->Range(256u, 8192u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_RSA_montgomery_sqr_32(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto const num_bits = std::size_t(state.range(0));
+
+	auto n = rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits);
+	n.set_bit(0u, true);
+
+	auto const context = rsa::math::montgomery_context<std::uint32_t>(n);
+	auto const a = context.to_montgomery(rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(context.sqr(a));
+
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_montgomery_sqr_32)->RangeMultiplier(2u)->Range(256u, 8192u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// montgomery multiplication of fixed size numbers (compare with BM_RSA_montgomery_mul_32)
+
+template<std::size_t bits>
+static void BM_RSA_fixed_montgomery_mul_32(benchmark::State& state)
+{
+	using fixed_t = rsa::math::fixed_uint<bits, std::uint32_t>;
+
+	auto rng = std::mt19937_64();
+
+	auto n = rsa::math::generate_random_bits<std::uint32_t>(rng, bits - 1u);
+	n.set_bit(0u, true);
+	n.set_bit(bits - 1u, true);
+
+	auto const context = rsa::math::fixed_montgomery_context<bits, std::uint32_t>(fixed_t(n));
+	auto const a = context.to_montgomery(fixed_t(rsa::math::generate_random_bits<std::uint32_t>(rng, bits - 1u)));
+	auto const b = context.to_montgomery(fixed_t(rsa::math::generate_random_bits<std::uint32_t>(rng, bits - 1u)));
+
+	auto const allocations_before = allocation_count;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(context.mul(a, b));
+
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_TEMPLATE(BM_RSA_fixed_montgomery_mul_32, 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_RSA_fixed_montgomery_mul_32, 2048)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_RSA_fixed_montgomery_mul_32, 4096)->Unit(benchmark::kMicrosecond);
+
+// repeated reduction of double size values by the same modulus (compare with BM_RSA_barrett_reduce_32)
+
+static void BM_RSA_mod_assign_32(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto const num_bits = std::size_t(state.range(0));
+
+	auto const m = rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits) + 1u;
+	auto const x = rsa::math::generate_random_bits<std::uint32_t>(rng, 2u * num_bits);
+
+	for (auto _ : state)
+	{
+		auto a = x;
+		benchmark::DoNotOptimize(a %= m);
+	}
+
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_mod_assign_32)->RangeMultiplier(2u)->Range(256u, 8192u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_RSA_barrett_reduce_32(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto const num_bits = std::size_t(state.range(0));
+
+	auto const m = rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits) + 1u;
+	auto const x = rsa::math::generate_random_bits<std::uint32_t>(rng, 2u * num_bits);
+
+	auto const context = rsa::math::barrett_context<std::uint32_t>(m);
+
+	for (auto _ : state)
+	{
+		auto a = x;
+		context.reduce(a);
+		benchmark::DoNotOptimize(a);
+	}
+
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_barrett_reduce_32)->RangeMultiplier(2u)->Range(256u, 8192u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// modular exponentiation, with modulus and exponent of the same size in bits
+
+template<class block_t>
+static void run_mod_pow(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto const num_bits = std::size_t(state.range(0));
+
+	auto mod = rsa::math::generate_random_bits<block_t>(rng, num_bits);
+	mod.set_bit(0u, true);
+
+	auto const base = rsa::math::generate_random_bits<block_t>(rng, num_bits) % mod;
+	auto const exp = rsa::math::generate_random_bits<block_t>(rng, num_bits);
+
+	auto const allocations_before = allocation_count;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(rsa::math::mod_pow(base, exp, mod));
+
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+	state.SetComplexityN(state.range(0));
+}
+
+static void BM_RSA_mod_pow_32(benchmark::State& state)
+{
+	run_mod_pow<std::uint32_t>(state);
+}
+
+BENCHMARK(BM_RSA_mod_pow_32)->RangeMultiplier(2u)->Range(1024u, 4096u)->Complexity(benchmark::oNCubed)->Unit(benchmark::kMillisecond);
+
+#if defined(__SIZEOF_INT128__)
+
+static void BM_RSA_mod_pow_64(benchmark::State& state)
+{
+	run_mod_pow<std::uint64_t>(state);
+}
+
+BENCHMARK(BM_RSA_mod_pow_64)->RangeMultiplier(2u)->Range(1024u, 4096u)->Complexity(benchmark::oNCubed)->Unit(benchmark::kMillisecond);
+
+#endif
+
+// operations with integer operands (the small operations done in is_prime_rm)
+
+template<class operand_t>
+static void run_scalar_operations_32(benchmark::State& state, operand_t make_operand)
+{
+	auto rng = std::mt19937_64();
+	auto n = rsa::math::generate_random_bits<std::uint32_t>(rng, std::size_t(state.range(0)));
+	n.set_bit(0u, true);
+
+	auto m = n;
+	auto r = n;
+	auto found = 0u;
+
+	auto const allocations_before = allocation_count;
+
+	for (auto _ : state)
+	{
+		for (auto const p : rsa::math::first_100_primes)
+		{
+			r = n; // (reuses the storage of r)
+			r %= make_operand(p);
+			found += (r == make_operand(0u)) ? 1u : 0u;
+		}
+
+		found += (n > make_operand(2u)) ? 1u : 0u;
+		found += (n == make_operand(1u)) ? 1u : 0u;
+
+		m -= make_operand(1u);
+		m /= make_operand(2u);
+		m *= make_operand(2u);
+		m += make_operand(1u);
+		found += (m >= make_operand(3u)) ? 1u : 0u;
+	}
+
+	benchmark::DoNotOptimize(found);
+
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+	state.SetComplexityN(state.range(0));
+}
+
+static void BM_RSA_scalar_operations_32(benchmark::State& state)
+{
+	run_scalar_operations_32(state, [] (std::uint32_t x) { return x; });
+}
+
+BENCHMARK(BM_RSA_scalar_operations_32)->RangeMultiplier(4u)->Range(64u, 4096u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_RSA_scalar_operations_as_big_uint_32(benchmark::State& state)
+{
+	run_scalar_operations_32(state, [] (std::uint32_t x) { return rsa::math::big_uint_32(x); });
+}
+
+BENCHMARK(BM_RSA_scalar_operations_as_big_uint_32)->RangeMultiplier(4u)->Range(64u, 4096u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// c = a * b, with the product written to an existing number or a new one
+
+static void BM_RSA_mul_out_32(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto const a = rsa::math::generate_random_bits<std::uint32_t>(rng, std::size_t(state.range(0)));
+	auto const b = rsa::math::generate_random_bits<std::uint32_t>(rng, std::size_t(state.range(0)));
+	auto c = rsa::math::big_uint_32();
+
+	auto const allocations_before = allocation_count;
+
+	for (auto _ : state)
+	{
+		rsa::math::ops::mul(c, a, b);
+		benchmark::DoNotOptimize(c);
+	}
+
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_mul_out_32)->RangeMultiplier(4u)->Range(256u, 16384u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_RSA_mul_operator_32(benchmark::State& state)
+{
+	auto rng = std::mt19937_64();
+	auto const a = rsa::math::generate_random_bits<std::uint32_t>(rng, std::size_t(state.range(0)));
+	auto const b = rsa::math::generate_random_bits<std::uint32_t>(rng, std::size_t(state.range(0)));
+	auto c = rsa::math::big_uint_32();
+
+	auto const allocations_before = allocation_count;
+
+	for (auto _ : state)
+	{
+		c = a * b;
+		benchmark::DoNotOptimize(c);
+	}
+
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_mul_operator_32)->RangeMultiplier(4u)->Range(256u, 16384u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// modular exponentiation written with the free operators (as the old `power` lambda in is_prime_rm), so every step makes temporaries
+static void BM_RSA_power_operators_32(benchmark::State& state)
+{
+	using big_uint_t = rsa::math::big_uint_32;
+
+	auto const power = [] (big_uint_t x, big_uint_t y, big_uint_t const& n)
+	{
+		auto result = big_uint_t(1u);
+		x %= n;
+
+		while (!y.is_zero())
+		{
+			if (y.get_bit(0u))
+				result = (result * x) % n;
+
+			y >>= 1u;
+			x = (x * x) % n;
+		}
+
+		return result;
+	};
+
+	auto rng = std::mt19937_64();
+	auto const bits = std::size_t(state.range(0));
+	auto const x = rsa::math::generate_random_bits<std::uint32_t>(rng, bits);
+	auto const y = rsa::math::generate_random_bits<std::uint32_t>(rng, 64u);
+	auto const n = rsa::math::generate_random_bits<std::uint32_t>(rng, bits) | (big_uint_t(1u) <<= (bits - 1u));
+
+	auto const allocations_before = allocation_count;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(power(x, y, n));
+
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_power_operators_32)->RangeMultiplier(2u)->Range(256u, 4096u)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// as above, with the steps written as expressions (the products are reduced in the workspace)
+static void BM_RSA_power_expressions_32(benchmark::State& state)
+{
+	using big_uint_t = rsa::math::big_uint_32;
+	using rsa::math::expr::lazy;
+
+	auto const power = [] (big_uint_t x, big_uint_t y, big_uint_t const& n)
+	{
+		auto result = big_uint_t(1u);
+		x %= n;
+
+		while (!y.is_zero())
+		{
+			if (y.get_bit(0u))
+				rsa::math::expr::assign(result, (lazy(result) * x) % n);
+
+			y >>= 1u;
+			rsa::math::expr::assign(x, (lazy(x) * lazy(x)) % n);
+		}
+
+		return result;
+	};
+
+	auto rng = std::mt19937_64();
+	auto const bits = std::size_t(state.range(0));
+	auto const x = rsa::math::generate_random_bits<std::uint32_t>(rng, bits);
+	auto const y = rsa::math::generate_random_bits<std::uint32_t>(rng, 64u);
+	auto const n = rsa::math::generate_random_bits<std::uint32_t>(rng, bits) | (big_uint_t(1u) <<= (bits - 1u));
+
+	auto const allocations_before = allocation_count;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(power(x, y, n));
+
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_power_expressions_32)->RangeMultiplier(2u)->Range(256u, 4096u)->Complexity()->Unit(benchmark::kMicrosecond);
 
 static void BM_RSA_generate_prime_rm(benchmark::State& state)
 {
 	auto rng = std::mt19937_64(5489u);
 	auto k = 20u;
 
+	auto const allocations_before = allocation_count;
+
 	for (auto _ : state)
 		benchmark::DoNotOptimize(rsa::math::generate_prime_rm<std::uint32_t>(rng, std::size_t(state.range(0)), k));
+
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_generate_prime_rm)->RangeMultiplier(2u)->Range(16u, 4096u)->Complexity()->Unit(benchmark::kMillisecond);
+
+// as above, testing candidates with baillie-psw instead of 20 miller-rabin rounds
+static void BM_RSA_generate_prime_bpsw(benchmark::State& state)
+{
+	auto rng = std::mt19937_64(5489u);
+
+	auto const allocations_before = allocation_count;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(rsa::math::generate_prime_bpsw<std::uint32_t>(rng, std::size_t(state.range(0))));
+
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_generate_prime_bpsw)->RangeMultiplier(2u)->Range(16u, 4096u)->Complexity()->Unit(benchmark::kMillisecond);
+
+// generate_prime_rm without the sieve (every candidate in the window goes through is_prime_rm), for comparison
+static void BM_RSA_generate_prime_rm_unsieved(benchmark::State& state)
+{
+	using big_uint_t = rsa::math::big_uint_32;
+
+	auto const generate_prime = [] (std::mt19937_64& rng, std::size_t num_bits, std::size_t k)
+	{
+		while (true)
+		{
+			auto random_bits = rsa::math::generate_random_bits<std::uint32_t>(rng, num_bits);
+			random_bits.set_bit(0u, true);
+			random_bits.set_bit(num_bits - 1u, true);
+
+			auto const two = big_uint_t(2u);
+
+			for (auto i = std::size_t{ 0 }; i != 2u * num_bits; ++i)
+			{
+				if (rsa::math::is_prime_rm(random_bits, rng, k))
+					return random_bits;
+
+				random_bits += two;
+			}
+		}
+	};
+
+	auto rng = std::mt19937_64(5489u);
+	auto k = 20u;
+
+	auto const allocations_before = allocation_count;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(generate_prime(rng, std::size_t(state.range(0)), k));
+
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+	state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RSA_generate_prime_rm_unsieved)->RangeMultiplier(2u)->Range(16u, 2048u)->Complexity()->Unit(benchmark::kMillisecond);
+
+// as above, with the numbers allocated from a monotonic arena (one per prime, reusing the same initial buffer)
+static void BM_RSA_generate_prime_rm_arena(benchmark::State& state)
+{
+	auto rng = std::mt19937_64(5489u);
+	auto k = 20u;
+
+	auto buffer = std::vector<std::byte>(std::size_t{ 1 } << 20u);
+
+	auto const allocations_before = allocation_count;
+
+	for (auto _ : state)
+	{
+		auto arena = std::pmr::monotonic_buffer_resource(buffer.data(), buffer.size());
+		benchmark::DoNotOptimize(rsa::math::generate_prime_rm<std::uint32_t>(rng, std::size_t(state.range(0)), k, rsa::math::default_workspace<std::uint32_t>(), &arena));
+	}
+
+	state.counters["allocations"] = benchmark::Counter(double(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+	state.SetComplexityN(state.range(0));
 }
 
-BENCHMARK(BM_RSA_generate_prime_rm)->RangeMultiplier(2u)->Range(16u, 1024u)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RSA_generate_prime_rm_arena)->RangeMultiplier(2u)->Range(16u, 1024u)->Complexity()->Unit(benchmark::kMillisecond);
 
 BENCHMARK_MAIN();
@@ -0,0 +1,99 @@
+#include "rsa_math__barrett.h"
+#include "rsa_math__primes.h"
+#include "test_utils__uint_max.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+namespace test
+{
+
+	namespace
+	{
+
+		template<class block_t>
+		bool test_barrett_random(std::mt19937_64& rng, std::size_t modulus_bits, std::size_t count)
+		{
+			auto const modulus = rsa::math::generate_random_bits<block_t>(rng, modulus_bits) + 1u;
+			auto const context = rsa::math::barrett_context<block_t>(modulus);
+
+			for (auto i = std::size_t{ 0 }; i != count; ++i)
+			{
+				// up to b^2k, and beyond (the fallback)
+				auto const x = rsa::math::generate_random_bits<block_t>(rng, (2u + i % 3u) * modulus_bits);
+
+				if (context.mod(x) != x % modulus)
+					return false;
+
+				auto const a = x % modulus;
+				auto const b = rsa::math::generate_random_bits<block_t>(rng, modulus_bits) % modulus;
+
+				if (context.mul(a, b) != (a * b) % modulus)
+					return false;
+
+				if (context.sqr(a) != (a * a) % modulus)
+					return false;
+
+				auto c = a;
+				context.mul_assign(c, c);
+
+				if (c != (a * a) % modulus)
+					return false;
+			}
+
+			return true;
+		}
+
+	} // unnamed
+
+	TEST(Test_RSA, math_barrett_constructor__ThrowsForZeroModulus)
+	{
+		EXPECT_THROW(rsa::math::barrett_context<std::uint32_t>(rsa::math::big_uint_32()), std::invalid_argument);
+		EXPECT_NO_THROW(rsa::math::barrett_context<std::uint32_t>(rsa::math::big_uint_32(1u)));
+	}
+
+	TEST(Test_RSA, math_barrett_mod__Value)
+	{
+		auto const context = rsa::math::barrett_context<std::uint16_t>(rsa::math::big_uint_16(1000u));
+
+		EXPECT_EQ(context.mod(rsa::math::big_uint_16(999u)), 999u);
+		EXPECT_EQ(context.mod(rsa::math::big_uint_16(1000u)), 0u);
+		EXPECT_EQ(context.mod(rsa::math::big_uint_16(123456u)), 456u);
+		EXPECT_EQ(context.mul(rsa::math::big_uint_16(999u), rsa::math::big_uint_16(999u)), 1u);
+		EXPECT_EQ(context.mod(rsa::math::big_uint_16(utils::uint64_max)), utils::uint64_max % 1000u);
+	}
+
+	TEST(Test_RSA, math_barrett_mod__MatchesMod)
+	{
+		auto rng = std::mt19937_64();
+
+		for (auto bits : { 1u, 8u, 31u, 64u, 65u, 200u, 521u, 1024u, 1600u })
+		{
+			EXPECT_TRUE(test_barrett_random<std::uint8_t>(rng, bits, 10u));
+			EXPECT_TRUE(test_barrett_random<std::uint16_t>(rng, bits, 10u));
+			EXPECT_TRUE(test_barrett_random<std::uint32_t>(rng, bits, 10u));
+#if defined(__SIZEOF_INT128__)
+			EXPECT_TRUE(test_barrett_random<std::uint64_t>(rng, bits, 10u));
+#endif
+		}
+	}
+
+	TEST(Test_RSA, math_barrett_mod__MaxValues)
+	{
+		// all bits set (largest possible quotient estimates)
+		auto const m = rsa::math::big_uint_32(16u, utils::uint32_max);
+		auto const context = rsa::math::barrett_context<std::uint32_t>(m);
+
+		auto const x = rsa::math::big_uint_32(32u, utils::uint32_max);
+		EXPECT_EQ(context.mod(x), x % m);
+		EXPECT_EQ(context.sqr(m - 1u), 1u);
+
+		// power of 2 modulus
+		auto const p = (rsa::math::big_uint_32(1u) <<= 100u);
+		EXPECT_EQ(rsa::math::barrett_context<std::uint32_t>(p).mod(x), x % p);
+	}
+
+} // test
@@ -1,12 +1,21 @@
 
 #include "rsa_math__big_uint.h"
+#include "rsa_math__mod_pow.h"
+#include "test_utils__counting_resource.h"
+#include "test_utils__random_big_uint.h"
+#include "test_utils__scoped_thresholds.h"
 #include "test_utils__uint_max.h"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <memory_resource>
 #include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace test
 {
@@ -121,11 +130,48 @@ namespace test
 		}
 	}
 
+	TEST(Test_RSA, math_big_uint_constructor_allocator__PropagatesToTemporaries)
+	{
+		auto arena = utils::counting_resource();
+		auto default_resource = utils::counting_resource();
+		auto const scoped_default = utils::scoped_default_resource(&default_resource);
+
+		auto const a = rsa::math::big_uint_32(std::size_t{ 40 }, 0x9abcdef1u, &arena);
+		auto const b = rsa::math::big_uint_32(std::size_t{ 12 }, 0x12345677u, &arena);
+		EXPECT_EQ(arena.allocations(), 2u);
+
+		auto const copy = a;
+		EXPECT_EQ(copy.get_allocator().resource(), &arena);
+
+		auto const moved_copy = rsa::math::big_uint_32(rsa::math::big_uint_32(a), &arena);
+		EXPECT_EQ(moved_copy, a);
+
+		EXPECT_EQ((a * b).get_allocator().resource(), &arena);
+		EXPECT_EQ((a / b).get_allocator().resource(), &arena);
+		EXPECT_EQ((a % b).get_allocator().resource(), &arena);
+		EXPECT_EQ((a - 1u).get_allocator().resource(), &arena);
+		EXPECT_EQ((utils::uint64_max % b).get_allocator().resource(), &arena);
+		EXPECT_EQ(rsa::math::mod_pow(b, a, a).get_allocator().resource(), &arena);
+		EXPECT_EQ(rsa::math::mod_pow(b, a, a - 1u).get_allocator().resource(), &arena);
+
+		EXPECT_EQ(default_resource.allocations(), 0u);
+
+		// (assignment keeps the allocator of the assigned-to number)
+		auto c = rsa::math::big_uint_32();
+		c = a;
+		EXPECT_EQ(c.get_allocator().resource(), &default_resource);
+		EXPECT_EQ(c, a);
+
+		auto const copy_elsewhere = rsa::math::big_uint_32(a, std::pmr::new_delete_resource());
+		EXPECT_EQ(copy_elsewhere.get_allocator().resource(), std::pmr::new_delete_resource());
+		EXPECT_EQ(copy_elsewhere, a);
+	}
+
 #pragma endregion
 
 #pragma region assignment
 
-	// not testing copy / move (default)
+	// not testing copy / move (default, except for allocators, tested above)
 
 	TEST(Test_RSA, math_big_uint_value_assign)
 	{
@@ -268,6 +314,26 @@ namespace test
 		}
 	}
 
+	TEST(Test_RSA, math_big_uint_get_least_significant_bit)
+	{
+		{
+			auto n = rsa::math::big_uint_32(0u);
+			EXPECT_THROW(n.get_least_significant_bit(), std::logic_error);
+		}
+		{
+			auto n = rsa::math::big_uint_32(1u);
+			EXPECT_EQ(n.get_least_significant_bit(), 0u);
+		}
+		{
+			auto n = rsa::math::big_uint_32(20u);
+			EXPECT_EQ(n.get_least_significant_bit(), 2u);
+		}
+		{
+			auto n = rsa::math::big_uint_16({ 0x0u, 0x0u, 0x8000u, 0x1u });
+			EXPECT_EQ(n.get_least_significant_bit(), 47u);
+		}
+	}
+
 #pragma endregion
 
 #pragma region bitwise operators
@@ -697,6 +763,188 @@ namespace test
 		}
 	}
 
+	TEST(Test_RSA, math_big_uint_mulassign__Karatsuba)
+	{
+		auto rng = std::mt19937_64();
+
+		auto const sizes = std::vector<std::pair<std::size_t, std::size_t>>
+		{
+			{ 4, 4 }, { 5, 5 }, { 33, 33 }, { 64, 64 }, { 101, 100 }, { 257, 257 }, { 300, 70 }, { 70, 300 }, { 129, 32 },
+		};
+
+		auto& thresholds = rsa::math::ops::thresholds();
+		auto const scoped_thresholds = utils::scoped_thresholds();
+
+		for (auto const& s : sizes)
+		{
+			auto const a = utils::random_big_uint<rsa::math::big_uint_32>(rng, s.first);
+			auto const b = utils::random_big_uint<rsa::math::big_uint_32>(rng, s.second);
+
+			thresholds.karatsuba = utils::uint32_max;
+			auto const expected = a * b;
+
+			thresholds.karatsuba = 4u;
+			EXPECT_EQ(a * b, expected);
+
+			thresholds.karatsuba = scoped_thresholds.previous().karatsuba;
+			EXPECT_EQ(a * b, expected);
+		}
+
+		// all blocks max (carries through every level)
+		{
+			auto const a = rsa::math::big_uint_32(200u, utils::uint32_max);
+
+			thresholds.karatsuba = utils::uint32_max;
+			auto const expected = a * a;
+
+			thresholds.karatsuba = 4u;
+			EXPECT_EQ(a * a, expected);
+		}
+	}
+
+	TEST(Test_RSA, math_big_uint_mulassign__Toom3)
+	{
+		auto rng = std::mt19937_64();
+
+		auto const sizes = std::vector<std::pair<std::size_t, std::size_t>>
+		{
+			{ 9, 9 }, { 10, 10 }, { 11, 11 }, { 27, 27 }, { 100, 100 }, { 301, 300 }, { 500, 90 }, { 90, 500 },
+		};
+
+		auto& thresholds = rsa::math::ops::thresholds();
+
+		for (auto const& s : sizes)
+		{
+			auto const a = utils::random_big_uint<rsa::math::big_uint_32>(rng, s.first);
+			auto const b = utils::random_big_uint<rsa::math::big_uint_32>(rng, s.second);
+			auto const scoped_thresholds = utils::scoped_thresholds();
+
+			thresholds.karatsuba = utils::uint32_max;
+			thresholds.toom3 = utils::uint32_max;
+			auto const expected = a * b;
+
+			// toom-3 all the way down to schoolbook
+			thresholds.toom3 = 9u;
+			EXPECT_EQ(a * b, expected);
+
+			// toom-3, then karatsuba, then schoolbook
+			thresholds.karatsuba = 4u;
+			thresholds.toom3 = 24u;
+			EXPECT_EQ(a * b, expected);
+		}
+
+		// all blocks max (carries and negative intermediates in the interpolation)
+		{
+			auto const a = rsa::math::big_uint_32(200u, utils::uint32_max);
+			auto b = rsa::math::big_uint_32(1u);
+			b.set_bit(199u * 32u, true);
+			auto const scoped_thresholds = utils::scoped_thresholds();
+
+			thresholds.karatsuba = utils::uint32_max;
+			thresholds.toom3 = utils::uint32_max;
+			auto const expected_aa = a * a;
+			auto const expected_ab = a * b;
+
+			thresholds.toom3 = 9u;
+			EXPECT_EQ(a * a, expected_aa);
+			EXPECT_EQ(a * b, expected_ab);
+		}
+	}
+
+	TEST(Test_RSA, math_big_uint_mulassign__Ntt)
+	{
+		auto rng = std::mt19937_64();
+
+		auto const sizes = std::vector<std::pair<std::size_t, std::size_t>>
+		{
+			{ 1, 1 }, { 2, 1 }, { 9, 9 }, { 64, 64 }, { 301, 300 }, { 1000, 90 }, { 90, 1000 },
+		};
+
+		auto& thresholds = rsa::math::ops::thresholds();
+
+		auto const run_test = [&] (auto const& a, auto const& b)
+		{
+			auto const scoped_thresholds = utils::scoped_thresholds();
+
+			thresholds = { utils::uint32_max, utils::uint32_max, utils::uint32_max };
+			auto const expected = a * b;
+
+			// ntt whenever the operands are big enough for toom-3
+			thresholds = { 4u, 9u, 0u };
+			auto const result = a * b;
+
+			return (result == expected);
+		};
+
+		for (auto const& s : sizes)
+		{
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_8>(rng, s.first), utils::random_big_uint<rsa::math::big_uint_8>(rng, s.second)));
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_16>(rng, s.first), utils::random_big_uint<rsa::math::big_uint_16>(rng, s.second)));
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_32>(rng, s.first), utils::random_big_uint<rsa::math::big_uint_32>(rng, s.second)));
+		}
+
+		// all blocks max (largest possible convolution coefficients)
+		{
+			auto const a = rsa::math::big_uint_32(2000u, utils::uint32_max);
+			EXPECT_TRUE(run_test(a, a));
+		}
+	}
+
+	TEST(Test_RSA, math_big_uint_mulassign__Square)
+	{
+		auto rng = std::mt19937_64();
+
+		auto& thresholds = rsa::math::ops::thresholds();
+
+		auto const all_thresholds = std::vector<rsa::math::ops::thresholds_type>
+		{
+			{ utils::uint32_max, utils::uint32_max, utils::uint32_max }, // schoolbook
+			{ 4u, utils::uint32_max, utils::uint32_max }, // karatsuba
+			{ 4u, 9u, utils::uint32_max }, // toom-3
+			{ 4u, 9u, 0u }, // ntt
+		};
+
+		auto const run_test = [&] (auto const& a)
+		{
+			auto const scoped_thresholds = utils::scoped_thresholds();
+			auto const copy = a;
+
+			thresholds = { utils::uint32_max, utils::uint32_max, utils::uint32_max };
+			auto const expected = a * copy;
+
+			auto result = true;
+
+			for (auto const& t : all_thresholds)
+			{
+				thresholds = t;
+
+				auto s = a;
+				rsa::math::square(s);
+
+				auto m = a;
+				m *= m;
+
+				result = result && (s == expected) && (m == expected);
+			}
+
+			return result;
+		};
+
+		for (auto const size : { 1, 2, 3, 4, 5, 9, 10, 31, 64, 301 })
+		{
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_8>(rng, size)));
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_16>(rng, size)));
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_32>(rng, size)));
+		}
+
+		// all blocks max (largest possible carries)
+		EXPECT_TRUE(run_test(rsa::math::big_uint_32(100u, utils::uint32_max)));
+
+		// zero and one
+		EXPECT_TRUE(run_test(rsa::math::big_uint_32()));
+		EXPECT_TRUE(run_test(rsa::math::big_uint_32(1u)));
+	}
+
 	TEST(Test_RSA, math_big_uint_mulassign__Value)
 	{
 		auto a = rsa::math::big_uint_16(utils::uint8_max);
@@ -854,6 +1102,57 @@ namespace test
 		}
 	}
 
+	TEST(Test_RSA, math_big_uint_divmod__BurnikelZiegler)
+	{
+		auto rng = std::mt19937_64();
+
+		auto& thresholds = rsa::math::ops::thresholds();
+
+		auto const run_test = [&] (auto const& dividend, auto const& divisor)
+		{
+			using big_uint_t = std::decay_t<decltype(dividend)>;
+
+			auto const scoped_thresholds = utils::scoped_thresholds();
+			thresholds.burnikel_ziegler = utils::uint32_max;
+
+			auto expected_q = big_uint_t(); auto expected_r = big_uint_t();
+			rsa::math::ops::divmod_test(expected_q, expected_r, dividend, divisor);
+
+			auto result = (expected_q * divisor + expected_r == dividend) && (expected_r < divisor);
+
+			for (auto const t : { 2u, 3u, 5u, 16u })
+			{
+				thresholds.burnikel_ziegler = t;
+
+				auto q = big_uint_t(); auto r = big_uint_t();
+				rsa::math::ops::divmod_test(q, r, dividend, divisor);
+
+				result = result && (q == expected_q) && (r == expected_r);
+			}
+
+			return result;
+		};
+
+		auto const sizes = std::vector<std::pair<std::size_t, std::size_t>>
+		{
+			{ 4, 2 }, { 8, 4 }, { 9, 4 }, { 12, 5 }, { 20, 6 }, { 64, 32 }, { 65, 32 }, { 100, 17 }, { 101, 50 }, { 300, 64 },
+		};
+
+		for (auto const& size : sizes)
+		{
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_8>(rng, size.first), utils::random_big_uint<rsa::math::big_uint_8>(rng, size.second)));
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_16>(rng, size.first), utils::random_big_uint<rsa::math::big_uint_16>(rng, size.second)));
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_32>(rng, size.first), utils::random_big_uint<rsa::math::big_uint_32>(rng, size.second)));
+#if defined(__SIZEOF_INT128__)
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_64>(rng, size.first), utils::random_big_uint<rsa::math::big_uint_64>(rng, size.second)));
+#endif
+
+			// all blocks max (largest possible quotient estimates, most corrections)
+			EXPECT_TRUE(run_test(rsa::math::big_uint_32(size.first, utils::uint32_max), rsa::math::big_uint_32(size.second, utils::uint32_max)));
+			EXPECT_TRUE(run_test(rsa::math::big_uint_32(size.first, utils::uint32_max), (rsa::math::big_uint_32(1u) <<= (32u * size.second - 1u)) + 1u));
+		}
+	}
+
 	TEST(Test_RSA, math_big_uint_divassign__DivisionByZeroThrows)
 	{
 		EXPECT_THROW(rsa::math::big_uint_8(0u) /= rsa::math::big_uint_8(0u), std::invalid_argument);
@@ -971,6 +1270,65 @@ namespace test
 		}
 	}
 
+	TEST(Test_RSA, math_big_uint_modassign__MatchesDivmod)
+	{
+		auto rng = std::mt19937_64();
+
+		auto& thresholds = rsa::math::ops::thresholds();
+
+		auto const run_test = [&] (auto const& dividend, auto const& divisor)
+		{
+			using big_uint_t = std::decay_t<decltype(dividend)>;
+			using block_t = typename big_uint_t::block_type;
+
+			auto const scoped_thresholds = utils::scoped_thresholds();
+
+			auto q = big_uint_t(); auto expected = big_uint_t();
+			rsa::math::ops::divmod_test(q, expected, dividend, divisor);
+
+			auto result = true;
+			auto ws = rsa::math::workspace<block_t>();
+
+			for (auto const t : { utils::uint32_max, 2u })
+			{
+				thresholds.burnikel_ziegler = t;
+
+				auto a = dividend;
+				a %= divisor;
+
+				// (reusing the workspace)
+				auto b = dividend;
+				rsa::math::ops::mod_assign(b, divisor, ws);
+				auto c = dividend;
+				rsa::math::ops::mod_assign(c, divisor, ws);
+
+				result = result && (a == expected) && (b == expected) && (c == expected);
+			}
+
+			return result;
+		};
+
+		for (auto const& size : std::vector<std::pair<std::size_t, std::size_t>>{ { 1, 1 }, { 3, 1 }, { 2, 2 }, { 5, 2 }, { 9, 4 }, { 40, 13 }, { 40, 39 } })
+		{
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_8>(rng, size.first), utils::random_big_uint<rsa::math::big_uint_8>(rng, size.second)));
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_16>(rng, size.first), utils::random_big_uint<rsa::math::big_uint_16>(rng, size.second)));
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_32>(rng, size.first), utils::random_big_uint<rsa::math::big_uint_32>(rng, size.second)));
+#if defined(__SIZEOF_INT128__)
+			EXPECT_TRUE(run_test(utils::random_big_uint<rsa::math::big_uint_64>(rng, size.first), utils::random_big_uint<rsa::math::big_uint_64>(rng, size.second)));
+#endif
+		}
+
+		// normalized divisor (no shift), and a dividend that gains no block when shifted
+		EXPECT_TRUE(run_test(rsa::math::big_uint_32(7u, utils::uint32_max), rsa::math::big_uint_32(3u, utils::uint32_max)));
+		EXPECT_TRUE(run_test(rsa::math::big_uint_32(7u, 1u), rsa::math::big_uint_32(3u, 3u)));
+
+		// self modulus
+		{
+			auto a = rsa::math::big_uint_32(7u, 3u);
+			EXPECT_TRUE((a %= a).is_zero());
+		}
+	}
+
 	TEST(Test_RSA, math_big_uint_modassign__Value)
 	{
 		auto a = rsa::math::big_uint_16(utils::uint8_max);
@@ -984,6 +1342,319 @@ namespace test
 		EXPECT_EQ(908734u % rsa::math::big_uint_16(utils::uint64_max), 908734u);
 	}
 
+	TEST(Test_RSA, math_big_uint_scalar__MatchesBigUint)
+	{
+		auto rng = std::mt19937_64();
+		auto dist = std::uniform_int_distribution<std::uint64_t>(0u, utils::uint64_max);
+
+		auto const run_test = [&] (auto a, auto n)
+		{
+			using big_uint_t = decltype(a);
+			auto const b = big_uint_t(n);
+
+			auto result = true;
+
+			result = result && ((a + n) == (a + b)) && ((n + a) == (a + b));
+			result = result && ((a * n) == (a * b)) && ((n * a) == (a * b));
+			result = result && ((a & n) == (a & b)) && ((a | n) == (a | b)) && ((a ^ n) == (a ^ b));
+			result = result && ((a == n) == (a == b)) && ((n == a) == (b == a)) && ((a != n) == (a != b));
+			result = result && ((a < n) == (a < b)) && ((n < a) == (b < a)) && ((a <= n) == (a <= b)) && ((n <= a) == (b <= a));
+			result = result && ((a > n) == (a > b)) && ((n > a) == (b > a)) && ((a >= n) == (a >= b)) && ((n >= a) == (b >= a));
+
+			if (b <= a)
+				result = result && ((a - n) == (a - b));
+
+			if (!b.is_zero())
+				result = result && ((a / n) == (a / b)) && ((a % n) == (a % b));
+
+			auto c = a;
+			c = n;
+			result = result && (c == b);
+
+			return result;
+		};
+
+		auto const run_tests = [&] (auto a)
+		{
+			auto result = true;
+
+			for (auto const blocks : { 0u, 1u, 2u, 3u, 9u })
+			{
+				auto const n = dist(rng);
+
+				result = result && run_test(utils::random_big_uint<decltype(a)>(rng, blocks), std::uint8_t(n));
+				result = result && run_test(utils::random_big_uint<decltype(a)>(rng, blocks), std::uint16_t(n));
+				result = result && run_test(utils::random_big_uint<decltype(a)>(rng, blocks), std::uint32_t(n));
+				result = result && run_test(utils::random_big_uint<decltype(a)>(rng, blocks), std::uint64_t(n));
+				result = result && run_test(utils::random_big_uint<decltype(a)>(rng, blocks), std::uint64_t(n >> 40u));
+				result = result && run_test(utils::random_big_uint<decltype(a)>(rng, blocks), std::uint32_t{ 0 });
+				result = result && run_test(utils::random_big_uint<decltype(a)>(rng, blocks), std::uint32_t{ 1 });
+				result = result && run_test(utils::random_big_uint<decltype(a)>(rng, blocks), utils::uint64_max);
+			}
+
+			return result;
+		};
+
+		for (auto i = 0; i != 20; ++i)
+		{
+			EXPECT_TRUE(run_tests(rsa::math::big_uint_8()));
+			EXPECT_TRUE(run_tests(rsa::math::big_uint_16()));
+			EXPECT_TRUE(run_tests(rsa::math::big_uint_32()));
+#if defined(__SIZEOF_INT128__)
+			EXPECT_TRUE(run_tests(rsa::math::big_uint_64()));
+#endif
+		}
+
+		// carries and borrows through all blocks
+		EXPECT_EQ(rsa::math::big_uint_8(8u, utils::uint8_max) + 1u, rsa::math::big_uint_8(1u) <<= 64u);
+		EXPECT_EQ((rsa::math::big_uint_8(1u) <<= 64u) - 1u, rsa::math::big_uint_8(8u, utils::uint8_max));
+		EXPECT_EQ(rsa::math::big_uint_8(8u, utils::uint8_max) * utils::uint64_max, (rsa::math::big_uint_8(8u, utils::uint8_max) * rsa::math::big_uint_8(utils::uint64_max)));
+	}
+
+	TEST(Test_RSA, math_big_uint_ops_out__Aliasing)
+	{
+		auto rng = std::mt19937_64();
+
+		using n = rsa::math::big_uint_32;
+
+		for (auto const size : { 0u, 1u, 3u, 40u })
+		{
+			auto const a = utils::random_big_uint<rsa::math::big_uint_32>(rng, size + 2u);
+			auto const b = utils::random_big_uint<rsa::math::big_uint_32>(rng, size);
+
+			// distinct output
+			{
+				auto out = utils::random_big_uint<rsa::math::big_uint_32>(rng, 5u);
+				rsa::math::ops::add(out, a, b); EXPECT_EQ(out, a + b);
+				rsa::math::ops::sub(out, a, b); EXPECT_EQ(out, a - b);
+				rsa::math::ops::mul(out, a, b); EXPECT_EQ(out, a * b);
+				rsa::math::ops::sqr(out, a); EXPECT_EQ(out, a * a);
+			}
+
+			// output is the first operand
+			{
+				auto x = a; rsa::math::ops::add(x, x, b); EXPECT_EQ(x, a + b);
+				x = a; rsa::math::ops::sub(x, x, b); EXPECT_EQ(x, a - b);
+				x = a; rsa::math::ops::mul(x, x, b); EXPECT_EQ(x, a * b);
+				x = a; rsa::math::ops::sqr(x, x); EXPECT_EQ(x, a * a);
+			}
+
+			// output is the second operand
+			{
+				auto y = b; rsa::math::ops::add(y, a, y); EXPECT_EQ(y, a + b);
+				y = b; rsa::math::ops::sub(y, a, y); EXPECT_EQ(y, a - b);
+				y = b; rsa::math::ops::mul(y, a, y); EXPECT_EQ(y, a * b);
+			}
+
+			// all the same object
+			{
+				auto x = a; rsa::math::ops::add(x, x, x); EXPECT_EQ(x, a + a);
+				x = a; rsa::math::ops::sub(x, x, x); EXPECT_TRUE(x.is_zero());
+				x = a; rsa::math::ops::mul(x, x, x); EXPECT_EQ(x, a * a);
+			}
+
+			// division
+			if (!b.is_zero())
+			{
+				auto const q = a / b;
+				auto const r = a % b;
+
+				{ auto x = n(); auto y = n(); rsa::math::ops::divmod(x, y, a, b); EXPECT_EQ(x, q); EXPECT_EQ(y, r); }
+				{ auto x = a; auto y = n(); rsa::math::ops::divmod(x, y, x, b); EXPECT_EQ(x, q); EXPECT_EQ(y, r); }
+				{ auto x = n(); auto y = a; rsa::math::ops::divmod(x, y, y, b); EXPECT_EQ(x, q); EXPECT_EQ(y, r); }
+				{ auto x = b; auto y = n(); rsa::math::ops::divmod(x, y, a, x); EXPECT_EQ(x, q); EXPECT_EQ(y, r); }
+				{ auto x = n(); auto y = b; rsa::math::ops::divmod(x, y, a, y); EXPECT_EQ(x, q); EXPECT_EQ(y, r); }
+				{ auto x = a; auto y = b; rsa::math::ops::divmod(x, y, x, y); EXPECT_EQ(x, q); EXPECT_EQ(y, r); }
+				{ auto x = b; auto y = a; rsa::math::ops::divmod(x, y, y, x); EXPECT_EQ(x, q); EXPECT_EQ(y, r); }
+
+				// dividend smaller than divisor
+				{ auto x = b; auto y = n(); rsa::math::ops::divmod(x, y, b, a); EXPECT_TRUE(x.is_zero()); EXPECT_EQ(y, b); }
+				{ auto x = n(); auto y = b; rsa::math::ops::divmod(x, y, y, a); EXPECT_TRUE(x.is_zero()); EXPECT_EQ(y, b); }
+			}
+		}
+
+		{
+			auto x = n(); auto y = n();
+			EXPECT_THROW(rsa::math::ops::divmod(x, y, n(3u), n()), std::invalid_argument);
+			EXPECT_THROW(rsa::math::ops::sub(x, n(3u), n(4u)), std::invalid_argument);
+		}
+	}
+
+	TEST(Test_RSA, math_big_uint_ops_out__ReusesStorage)
+	{
+		auto const a = rsa::math::big_uint_32(20u, 0x12345678u);
+		auto const b = rsa::math::big_uint_32(10u, 0x9abcdef0u);
+
+		auto out = rsa::math::big_uint_32();
+		out.data().reserve(64u);
+		auto const storage = out.data().data();
+
+		rsa::math::ops::add(out, a, b);
+		rsa::math::ops::sub(out, a, b);
+		rsa::math::ops::mul(out, a, b);
+		rsa::math::ops::sqr(out, a);
+
+		auto q = rsa::math::big_uint_32();
+		q.data().reserve(64u);
+		auto const q_storage = q.data().data();
+
+		rsa::math::ops::divmod(q, out, a, b);
+
+		EXPECT_EQ(out.data().data(), storage);
+		EXPECT_EQ(q.data().data(), q_storage);
+	}
+
+	TEST(Test_RSA, math_big_uint_operators_rvalue__Values)
+	{
+		auto const a = rsa::math::big_uint_32(20u, 0x12345678u);
+		auto const b = rsa::math::big_uint_32(10u, 0x9abcdef0u);
+
+		auto const copy = [] (rsa::math::big_uint_32 const& n) { return n; };
+
+		auto const check = [&] (auto const& op, rsa::math::big_uint_32 const& expected)
+		{
+			EXPECT_EQ(op(a, b), expected);
+			EXPECT_EQ(op(copy(a), b), expected);
+			EXPECT_EQ(op(a, copy(b)), expected);
+			EXPECT_EQ(op(copy(a), copy(b)), expected);
+			EXPECT_EQ(op(rsa::math::big_uint_view<std::uint32_t>(a), copy(b)), expected);
+		};
+
+		auto expected = rsa::math::big_uint_32();
+		auto remainder = rsa::math::big_uint_32();
+
+		rsa::math::ops::add(expected, a, b);
+		check([] (auto&& x, auto&& y) { return std::forward<decltype(x)>(x) + std::forward<decltype(y)>(y); }, expected);
+
+		rsa::math::ops::sub(expected, a, b);
+		check([] (auto&& x, auto&& y) { return std::forward<decltype(x)>(x) - std::forward<decltype(y)>(y); }, expected);
+
+		rsa::math::ops::mul(expected, a, b);
+		check([] (auto&& x, auto&& y) { return std::forward<decltype(x)>(x) * std::forward<decltype(y)>(y); }, expected);
+
+		rsa::math::ops::divmod(expected, remainder, a, b);
+		check([] (auto&& x, auto&& y) { return std::forward<decltype(x)>(x) % std::forward<decltype(y)>(y); }, remainder);
+
+		EXPECT_EQ(a / b, expected);
+		EXPECT_EQ(copy(a) / b, expected);
+		EXPECT_EQ(copy(a) / copy(b), expected);
+
+		// (dividend smaller than the divisor)
+		EXPECT_EQ(b % copy(a), b);
+	}
+
+	TEST(Test_RSA, math_big_uint_operators_rvalue__ReusesStorage)
+	{
+		auto const a = rsa::math::big_uint_32(20u, 0x12345678u);
+		auto const b = rsa::math::big_uint_32(10u, 0x9abcdef0u);
+		auto const n = rsa::math::big_uint_32(15u, 0x76543211u);
+
+		auto x = a;
+		x.data().reserve(64u);
+		auto const storage = x.data().data();
+
+		auto y = std::move(x) * b;
+		EXPECT_EQ(y.data().data(), storage);
+
+		auto z = std::move(y) % n;
+		EXPECT_EQ(z.data().data(), storage);
+
+		auto const z_value = z;
+		auto w = a % std::move(z);
+		EXPECT_EQ(w.data().data(), storage);
+		EXPECT_EQ(w, a % z_value);
+
+		// both operands are temporaries, but only the right one has space for the product
+		auto p = b;
+		auto q = a;
+		q.data().reserve(64u);
+		auto const q_storage = q.data().data();
+		ASSERT_LT(p.data().capacity(), a.data().size() + b.data().size());
+
+		auto const product = std::move(p) * std::move(q);
+		EXPECT_EQ(product.data().data(), q_storage);
+		EXPECT_EQ(product, a * b);
+
+		// one allocation (for the product), reused for the remainder
+		auto arena = utils::counting_resource();
+		auto const a_arena = rsa::math::big_uint_32(a, &arena);
+		auto const b_arena = rsa::math::big_uint_32(b, &arena);
+		auto const n_arena = rsa::math::big_uint_32(n, &arena);
+
+		auto const warm_up = (a_arena * b_arena) % n_arena; // (sizes the workspace)
+		auto const allocations_before = arena.allocations();
+
+		auto const result = (a_arena * b_arena) % n_arena;
+		EXPECT_EQ(result, warm_up);
+		EXPECT_EQ(arena.allocations() - allocations_before, 1u);
+	}
+
+	TEST(Test_RSA, math_big_uint_ops_blocks__MatchesBigUint)
+	{
+		auto rng = std::mt19937_64();
+		auto dist = std::uniform_int_distribution<std::uint32_t>(0u, utils::uint32_max);
+
+		auto const to_big_uint = [] (std::vector<std::uint32_t> const& blocks)
+		{
+			auto n = rsa::math::big_uint_32();
+			n.data().assign(blocks.begin(), blocks.end());
+			rsa::math::utils::trim(n);
+			return n;
+		};
+
+		auto& thresholds = rsa::math::ops::thresholds();
+		auto const scoped_thresholds = utils::scoped_thresholds();
+
+		for (auto const t : { utils::uint32_max, 2u })
+		{
+			thresholds.burnikel_ziegler = t;
+
+			for (auto const& sizes : { std::make_pair(1u, 1u), std::make_pair(7u, 1u), std::make_pair(9u, 4u), std::make_pair(60u, 17u) })
+			{
+				auto n = std::vector<std::uint32_t>(sizes.first);
+				auto d = std::vector<std::uint32_t>(sizes.second);
+				std::generate(n.begin(), n.end(), [&] () { return dist(rng); });
+				std::generate(d.begin(), d.end(), [&] () { return dist(rng); });
+				d.back() |= 1u;
+
+				auto const a = to_big_uint(n);
+				auto const b = to_big_uint(d);
+
+				// separate outputs
+				auto q = std::vector<std::uint32_t>(n.size() - d.size() + 1u);
+				auto r = std::vector<std::uint32_t>(d.size());
+				rsa::math::ops::blocks::tdiv_qr(q.data(), r.data(), n.data(), n.size(), d.data(), d.size());
+				EXPECT_EQ(to_big_uint(q), a / b);
+				EXPECT_EQ(to_big_uint(r), a % b);
+
+				// remainder only, over the dividend
+				auto x = n;
+				rsa::math::ops::blocks::tdiv_qr<std::uint32_t>(nullptr, x.data(), x.data(), x.size(), d.data(), d.size());
+				x.resize(d.size());
+				EXPECT_EQ(to_big_uint(x), a % b);
+
+				// remainders of several single block divisors
+				auto const divisors = std::vector<std::uint32_t>{ 3u, 0x10001u, d.back(), utils::uint32_max };
+				auto remainders = std::vector<std::uint32_t>(divisors.size());
+				rsa::math::ops::blocks::mod_1_n(remainders.data(), n.data(), n.size(), divisors.data(), divisors.size());
+
+				for (auto i = std::size_t{ 0 }; i != divisors.size(); ++i)
+					EXPECT_EQ(remainders[i], rsa::math::ops::mod(a, divisors[i]));
+
+				// shifts, overlapping by one block
+				auto s = n;
+				s.resize(n.size() + 2u);
+				s[n.size() + 1u] = rsa::math::ops::blocks::lshift(s.data() + 1u, s.data(), n.size(), 5u);
+				s[0] = 0u;
+				EXPECT_EQ(to_big_uint(s), a << (32u + 5u));
+
+				rsa::math::ops::blocks::rshift(s.data(), s.data() + 1u, n.size() + 1u, 7u);
+				s.resize(n.size() + 1u);
+				EXPECT_EQ(to_big_uint(s), a >> 2u);
+			}
+		}
+	}
+
 	TEST(Test_RSA, math_big_uint_increment)
 	{
 		{
@@ -1119,4 +1790,74 @@ namespace test
 
 #pragma endregion
 
+#if defined(__SIZEOF_INT128__)
+
+#pragma region 64 bit blocks
+
+	TEST(Test_RSA, math_big_uint_64__MatchesBigUint32)
+	{
+		auto rng = std::mt19937_64();
+
+		auto const to_32 = [] (rsa::math::big_uint_64 const& n)
+		{
+			auto result = rsa::math::big_uint_32();
+
+			for (auto const block : n.data())
+			{
+				result.data().push_back(static_cast<std::uint32_t>(block));
+				result.data().push_back(static_cast<std::uint32_t>(block >> 32u));
+			}
+
+			if (!result.data().empty() && result.data().back() == 0u)
+				result.data().pop_back();
+
+			return result;
+		};
+
+		auto const sizes = std::vector<std::pair<std::size_t, std::size_t>>
+		{
+			{ 1, 1 }, { 2, 1 }, { 2, 2 }, { 3, 2 }, { 8, 3 }, { 40, 40 }, { 70, 33 }, { 300, 100 },
+		};
+
+		for (auto const& size : sizes)
+		{
+			for (auto i = 0; i != 20; ++i)
+			{
+				auto const a = utils::random_big_uint_biased<rsa::math::big_uint_64>(rng, size.first);
+				auto const b = utils::random_big_uint_biased<rsa::math::big_uint_64>(rng, size.second);
+				auto const a_32 = to_32(a);
+				auto const b_32 = to_32(b);
+
+				EXPECT_EQ(to_32(a + b), a_32 + b_32);
+				EXPECT_EQ(to_32(a * b), a_32 * b_32);
+				EXPECT_EQ(to_32(a / b), a_32 / b_32);
+				EXPECT_EQ(to_32(a % b), a_32 % b_32);
+
+				if (a >= b)
+				{
+					EXPECT_EQ(to_32(a - b), a_32 - b_32);
+				}
+
+				auto sq = a;
+				EXPECT_EQ(to_32(rsa::math::square(sq)), a_32 * a_32);
+
+				EXPECT_EQ(to_32(a << 100u), a_32 << 100u);
+				EXPECT_EQ(to_32(a >> 67u), a_32 >> 67u);
+			}
+		}
+	}
+
+	TEST(Test_RSA, math_big_uint_64__Values)
+	{
+		EXPECT_EQ(rsa::math::big_uint_64(utils::uint64_max).data().size(), 1u);
+		EXPECT_EQ((rsa::math::big_uint_64(utils::uint64_max) + 1u).data().size(), 2u);
+		EXPECT_EQ((rsa::math::big_uint_64(utils::uint64_max) * utils::uint64_max) / utils::uint64_max, utils::uint64_max);
+		EXPECT_EQ((rsa::math::big_uint_64(utils::uint64_max) * utils::uint64_max) % (utils::uint64_max - 1u), 1u);
+		EXPECT_EQ(rsa::math::big_uint_64(std::uint64_t{ 1 } << 63u).to_uint<std::uint64_t>(), std::uint64_t{ 1 } << 63u);
+	}
+
+#pragma endregion
+
+#endif
+
 } // test
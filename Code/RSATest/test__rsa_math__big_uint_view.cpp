@@ -0,0 +1,158 @@
+#include "rsa_math__big_uint.h"
+#include "rsa_math__big_uint_view.h"
+#include "rsa_math__primes.h"
+#include "test_utils__counting_resource.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace test
+{
+
+	TEST(Test_RSA, math_big_uint_view_constructor__Trims)
+	{
+		auto const blocks = std::vector<std::uint16_t>{ 0x1234u, 0x0u, 0xabcdu, 0x0u, 0x0u };
+
+		auto const view = rsa::math::big_uint_view<std::uint16_t>(blocks.data(), blocks.size());
+		EXPECT_EQ(view.data().data(), blocks.data());
+		EXPECT_EQ(view.data().size(), 3u);
+		EXPECT_EQ(view, rsa::math::big_uint_16({ 0x1234u, 0x0u, 0xabcdu }));
+		EXPECT_TRUE(view.get_bit(32u));
+		EXPECT_FALSE(view.get_bit(33u));
+		EXPECT_EQ(view.get_most_significant_bit(), 47u);
+
+		EXPECT_TRUE(rsa::math::big_uint_view<std::uint16_t>(blocks.data() + 3u, 2u).is_zero());
+		EXPECT_TRUE(rsa::math::big_uint_view<std::uint16_t>().is_zero());
+		EXPECT_THROW(rsa::math::big_uint_view<std::uint16_t>().get_most_significant_bit(), std::logic_error);
+
+		auto const n = rsa::math::big_uint_16(std::uint64_t{ 0x123456789u });
+		auto const n_view = rsa::math::big_uint_view<std::uint16_t>(n);
+		EXPECT_EQ(n_view.data().data(), n.data().data());
+		EXPECT_EQ(rsa::math::big_uint_16(n_view), n);
+	}
+
+	TEST(Test_RSA, math_big_uint_view_comparison__Values)
+	{
+		auto const a_blocks = std::vector<std::uint32_t>{ 5u, 1u, 0u };
+		auto const a = rsa::math::big_uint_view<std::uint32_t>(a_blocks.data(), a_blocks.size());
+		auto const b = rsa::math::big_uint_32({ 6u, 1u });
+
+		EXPECT_TRUE(a < b);
+		EXPECT_TRUE(b > a);
+		EXPECT_TRUE(a != b);
+		EXPECT_TRUE(a <= a);
+		EXPECT_TRUE(a == rsa::math::big_uint_32({ 5u, 1u }));
+		EXPECT_TRUE(a == std::uint64_t{ 0x100000005u });
+		EXPECT_TRUE(5u < a);
+		EXPECT_TRUE(a >= rsa::math::big_uint_view<std::uint32_t>(b.data().data(), 1u));
+	}
+
+	TEST(Test_RSA, math_big_uint_view_ops__MatchesBigUint)
+	{
+		auto rng = std::mt19937_64();
+
+		for (auto i = 0u; i != 20u; ++i)
+		{
+			auto const a = rsa::math::generate_random_bits<std::uint32_t>(rng, 64u + i * 97u);
+			auto const b = rsa::math::generate_random_bits<std::uint32_t>(rng, 32u + i * 61u) + 1u;
+
+			// (external memory, with some high zero blocks)
+			auto a_blocks = std::vector<std::uint32_t>(a.data().begin(), a.data().end());
+			auto b_blocks = std::vector<std::uint32_t>(b.data().begin(), b.data().end());
+			a_blocks.resize(a_blocks.size() + 2u);
+			b_blocks.resize(b_blocks.size() + 1u);
+
+			auto const a_view = rsa::math::big_uint_view<std::uint32_t>(a_blocks.data(), a_blocks.size());
+			auto const b_view = rsa::math::big_uint_view<std::uint32_t>(b_blocks.data(), b_blocks.size());
+
+			auto out = rsa::math::big_uint_32();
+
+			rsa::math::ops::mul(out, a_view, b_view);
+			EXPECT_EQ(out, a * b);
+
+			rsa::math::ops::sqr(out, a_view);
+			EXPECT_EQ(out, a * a);
+
+			rsa::math::ops::add(out, a_view, b);
+			EXPECT_EQ(out, a + b);
+
+			if (a >= b)
+			{
+				rsa::math::ops::sub(out, a_view, b_view);
+				EXPECT_EQ(out, a - b);
+			}
+
+			auto q = rsa::math::big_uint_32();
+			rsa::math::ops::divmod(q, out, a_view, b_view);
+			EXPECT_EQ(q, a / b);
+			EXPECT_EQ(out, a % b);
+
+			out = a;
+			rsa::math::ops::mod_assign(out, b_view);
+			EXPECT_EQ(out, a % b);
+
+			EXPECT_EQ(rsa::math::ops::mod(a_view, 1000003u), rsa::math::ops::mod(a, 1000003u));
+
+			EXPECT_EQ(a * b_view, a * b);
+			EXPECT_EQ(a % b_view, a % b);
+
+			out = b;
+			out += a_view;
+			EXPECT_EQ(out, a + b);
+		}
+	}
+
+	TEST(Test_RSA, math_big_uint_view_ops__Aliasing)
+	{
+		auto const a = rsa::math::big_uint_32({ 0x89abcdefu, 0x01234567u, 0x42u });
+		auto const b = rsa::math::big_uint_32({ 0xfedcba98u, 0x7u });
+
+		auto out = a;
+		rsa::math::ops::mul(out, rsa::math::big_uint_view<std::uint32_t>(out), b);
+		EXPECT_EQ(out, a * b);
+
+		out = a;
+		rsa::math::ops::mul(out, out, rsa::math::big_uint_view<std::uint32_t>(out));
+		EXPECT_EQ(out, a * a);
+
+		out = b;
+		rsa::math::ops::sub(out, a, rsa::math::big_uint_view<std::uint32_t>(out));
+		EXPECT_EQ(out, a - b);
+
+		out = a;
+		rsa::math::ops::add(out, rsa::math::big_uint_view<std::uint32_t>(out), out);
+		EXPECT_EQ(out, a + a);
+	}
+
+	TEST(Test_RSA, math_big_uint_view_ops__DoesntCopyOperands)
+	{
+		auto rng = std::mt19937_64();
+
+		auto const a_blocks = rsa::math::generate_random_bits<std::uint32_t>(rng, 2048u).data();
+		auto const n_blocks = rsa::math::generate_random_bits<std::uint32_t>(rng, 1024u).data();
+
+		auto const a = rsa::math::big_uint_view<std::uint32_t>(a_blocks.data(), a_blocks.size());
+		auto const n = rsa::math::big_uint_view<std::uint32_t>(n_blocks.data(), n_blocks.size());
+
+		auto out = rsa::math::big_uint_32();
+		out.data().reserve(2u * a.data().size());
+
+		auto ws = rsa::math::workspace<std::uint32_t>();
+		rsa::math::ops::mul(out, a, n, ws); // (sizes the workspace)
+
+		auto resource = utils::counting_resource();
+		auto const scoped_default = utils::scoped_default_resource(&resource);
+
+		rsa::math::ops::mul(out, a, n, ws);
+		rsa::math::ops::mod_assign(out, n, ws);
+		EXPECT_TRUE(out < n);
+		EXPECT_TRUE(a > n);
+
+		EXPECT_EQ(resource.allocations(), 0u);
+	}
+
+} // test
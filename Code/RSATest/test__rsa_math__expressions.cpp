@@ -0,0 +1,123 @@
+#include "rsa_math__big_uint.h"
+#include "rsa_math__expressions.h"
+#include "rsa_math__primes.h"
+#include "test_utils__counting_resource.h"
+#include "test_utils__uint_max.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+namespace test
+{
+
+	TEST(Test_RSA, math_expressions__MatchesOperators)
+	{
+		using rsa::math::expr::lazy;
+
+		auto rng = std::mt19937_64();
+
+		for (auto i = 0u; i != 20u; ++i)
+		{
+			auto const a = rsa::math::generate_random_bits<std::uint32_t>(rng, 64u + i * 97u);
+			auto const b = rsa::math::generate_random_bits<std::uint32_t>(rng, 32u + i * 61u);
+			auto const c = rsa::math::generate_random_bits<std::uint32_t>(rng, 16u + i * 131u);
+			auto const n = rsa::math::generate_random_bits<std::uint32_t>(rng, 48u + i * 53u) + 1u;
+
+			EXPECT_EQ(rsa::math::big_uint_32((lazy(a) * b) % n), (a * b) % n);
+			EXPECT_EQ(rsa::math::big_uint_32(lazy(a) * b + c), a * b + c);
+			EXPECT_EQ(rsa::math::big_uint_32(c + lazy(a) * b), a * b + c);
+			EXPECT_EQ(rsa::math::big_uint_32(lazy(a) * lazy(a)), a * a);
+			EXPECT_EQ(rsa::math::big_uint_32((lazy(a) - 1u) * (lazy(a) - 1u)), (a - 1u) * (a - 1u));
+			EXPECT_EQ(rsa::math::big_uint_32((lazy(a) + b) % (lazy(n) + 3u)), (a + b) % (n + 3u));
+			EXPECT_EQ(rsa::math::big_uint_32(lazy(a) * b - c), a * b - c);
+			EXPECT_EQ(rsa::math::big_uint_32(lazy(a) % 7u), a % 7u);
+
+			auto const square = (a - 1u) * (a - 1u);
+			EXPECT_TRUE((lazy(a) - 1u) * (lazy(a) - 1u) == square);
+			EXPECT_TRUE((lazy(a) - 1u) * (lazy(a) - 1u) <= square);
+			EXPECT_TRUE((lazy(a) - 1u) * (lazy(a) - 1u) < square + 1u);
+			EXPECT_TRUE((lazy(a) - 1u) * (lazy(a) - 1u) > square - 1u);
+			EXPECT_TRUE(square >= (lazy(a) - 1u) * (lazy(a) - 1u));
+			EXPECT_TRUE(lazy(a) * b != square);
+			EXPECT_EQ(lazy(a) * b < n, a * b < n);
+			EXPECT_EQ(lazy(a) * b > c, a * b > c);
+			EXPECT_EQ(lazy(a) % n == 0u, a % n == 0u);
+		}
+
+		auto const zero = rsa::math::big_uint_32();
+		auto const one = rsa::math::big_uint_32(1u);
+		auto const max = rsa::math::big_uint_32(utils::uint64_max);
+
+		EXPECT_EQ(rsa::math::big_uint_32(lazy(zero) * one + one), one);
+		EXPECT_EQ(rsa::math::big_uint_32(lazy(one) % 5u), one);
+		EXPECT_TRUE(lazy(zero) * one == 0u);
+		EXPECT_TRUE(lazy(zero) * one < one);
+		EXPECT_TRUE(lazy(one) * one == one);
+		EXPECT_TRUE(lazy(max) * 2u == rsa::math::big_uint_32({ 0xfffffffeu, 0xffffffffu, 1u }));
+
+		EXPECT_THROW(rsa::math::big_uint_32(lazy(one) - 2u), std::invalid_argument);
+		EXPECT_THROW(rsa::math::big_uint_32(lazy(one) % zero), std::invalid_argument);
+	}
+
+	TEST(Test_RSA, math_expressions_assign__Aliasing)
+	{
+		using rsa::math::expr::lazy;
+
+		auto a = rsa::math::big_uint_32({ 0x9abcdef1u, 0x12345678u, 0x0fedcba9u });
+		auto const b = rsa::math::big_uint_32({ 0x87654321u, 0x1u });
+		auto const n = rsa::math::big_uint_32({ 0x11111111u, 0x22222222u });
+
+		auto expected = (a * b) % n;
+		rsa::math::expr::assign(a, (lazy(a) * b) % n);
+		EXPECT_EQ(a, expected);
+
+		expected = a * a + a;
+		rsa::math::expr::assign(a, lazy(a) * lazy(a) + a);
+		EXPECT_EQ(a, expected);
+
+		expected = a;
+		rsa::math::expr::assign(a, lazy(a));
+		EXPECT_EQ(a, expected);
+
+		// (a is less than the divisor, so the remainder is a itself)
+		rsa::math::expr::assign(a, lazy(a) % (lazy(a) + 1u));
+		EXPECT_EQ(a, expected);
+	}
+
+	TEST(Test_RSA, math_expressions_assign__DoesntAllocate)
+	{
+		using rsa::math::expr::lazy;
+
+		auto arena = utils::counting_resource();
+		auto default_resource = utils::counting_resource();
+		auto const scoped_default = utils::scoped_default_resource(&default_resource);
+
+		auto const a = rsa::math::big_uint_32(std::size_t{ 40 }, 0x9abcdef1u, &arena);
+		auto const b = rsa::math::big_uint_32(std::size_t{ 40 }, 0x12345677u, &arena);
+		auto const n = rsa::math::big_uint_32(std::size_t{ 40 }, 0xfedcba98u, &arena);
+		auto out = rsa::math::big_uint_32(std::size_t{ 100 }, 0x0u, &arena);
+		auto const expected = (a * b + n) % n;
+
+		auto ws = rsa::math::workspace<std::uint32_t>();
+		rsa::math::expr::assign(out, (lazy(a) * b + n) % n, ws);
+		EXPECT_EQ(out, expected);
+
+		auto const allocations = arena.allocations();
+		auto const capacity = ws.capacity();
+
+		for (auto i = 0u; i != 3u; ++i)
+		{
+			rsa::math::expr::assign(out, (lazy(a) * b) % n, ws);
+			rsa::math::expr::assign(out, lazy(out) * lazy(out) + a, ws);
+			rsa::math::expr::assign(out, (lazy(out) + n) % n, ws);
+		}
+
+		EXPECT_EQ(arena.allocations(), allocations);
+		EXPECT_EQ(ws.capacity(), capacity);
+		EXPECT_EQ(default_resource.allocations(), 0u);
+	}
+
+} // test
@@ -0,0 +1,192 @@
+#include "rsa_math__fixed_montgomery.h"
+#include "rsa_math__fixed_uint.h"
+#include "rsa_math__montgomery.h"
+#include "rsa_math__primes.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+namespace test
+{
+
+	namespace
+	{
+
+		template<std::size_t bits, class block_t>
+		bool test_fixed_uint_random(std::mt19937_64& rng, std::size_t count)
+		{
+			using fixed_t = rsa::math::fixed_uint<bits, block_t>;
+			using big_t = rsa::math::big_uint<block_t>;
+
+			auto const wrap = (big_t(1u) <<= bits);
+
+			for (auto i = std::size_t{ 0 }; i != count; ++i)
+			{
+				// (including smaller values, with high zero blocks)
+				auto const a = rsa::math::generate_random_bits<block_t>(rng, bits - (i % 3u) * (bits / 4u) - 1u);
+				auto const b = rsa::math::generate_random_bits<block_t>(rng, bits - 1u);
+
+				auto const fa = fixed_t(a);
+				auto const fb = fixed_t(b);
+
+				if (fa.to_big_uint() != a)
+					return false;
+
+				if ((fa < fb) != (a < b) || (fa == fb) != (a == b) || (fa >= fb) != (a >= b))
+					return false;
+
+				auto sum = fixed_t();
+				auto const carry = rsa::math::ops::add(sum, fa, fb);
+
+				if (sum.to_big_uint() != (a + b) % wrap || (carry != 0u) != (a + b >= wrap))
+					return false;
+
+				auto difference = fixed_t();
+				auto const borrow = rsa::math::ops::sub(difference, fa, fb);
+
+				if (difference.to_big_uint() != (a + wrap - b) % wrap || (borrow != 0u) != (a < b))
+					return false;
+
+				auto product = rsa::math::fixed_uint<2u * bits, block_t>();
+				rsa::math::ops::mul(product, fa, fb);
+
+				if (product.to_big_uint() != a * b)
+					return false;
+
+				rsa::math::ops::sqr(product, fa);
+
+				if (product.to_big_uint() != a * a)
+					return false;
+			}
+
+			return true;
+		}
+
+		template<std::size_t bits, class block_t>
+		bool test_fixed_montgomery_random(std::mt19937_64& rng, std::size_t count)
+		{
+			using fixed_t = rsa::math::fixed_uint<bits, block_t>;
+
+			// (including a modulus smaller than R / b)
+			for (auto const modulus_bits : { bits, bits - rsa::math::utils::digits<block_t>() - 3u })
+			{
+				auto modulus = rsa::math::generate_random_bits<block_t>(rng, modulus_bits - 1u);
+				modulus.set_bit(0u, true);
+				modulus.set_bit(modulus_bits - 1u, true);
+
+				auto const fixed_context = rsa::math::fixed_montgomery_context<bits, block_t>(fixed_t(modulus));
+				auto const context = rsa::math::montgomery_context<block_t>(modulus);
+
+				if (fixed_context.from_montgomery(fixed_context.one()) != fixed_t(1u))
+					return false;
+
+				for (auto i = std::size_t{ 0 }; i != count; ++i)
+				{
+					auto const a = rsa::math::generate_random_bits<block_t>(rng, bits - 1u);
+					auto const b = rsa::math::generate_random_bits<block_t>(rng, bits - 1u);
+
+					auto const a_m = fixed_context.to_montgomery(fixed_t(a));
+					auto const b_m = fixed_context.to_montgomery(fixed_t(b));
+
+					if (fixed_context.from_montgomery(a_m).to_big_uint() != a % modulus)
+						return false;
+
+					if (fixed_context.from_montgomery(fixed_context.mul(a_m, b_m)).to_big_uint() != (a * b) % modulus)
+						return false;
+
+					if (fixed_context.from_montgomery(fixed_context.sqr(a_m)).to_big_uint() != (a * a) % modulus)
+						return false;
+
+					// the same values as montgomery_context when R is the same
+					if (modulus_bits == bits && fixed_context.mul(a_m, b_m).to_big_uint() != context.mul(a_m.to_big_uint(), b_m.to_big_uint()))
+						return false;
+
+					auto t = rsa::math::fixed_uint<2u * bits, block_t>();
+					rsa::math::ops::mul(t, a_m, b_m);
+
+					if (fixed_context.reduce(t) != fixed_context.mul(a_m, b_m))
+						return false;
+				}
+			}
+
+			return true;
+		}
+
+	} // unnamed
+
+	TEST(Test_RSA, math_fixed_uint_constructor__Values)
+	{
+		EXPECT_TRUE(rsa::math::fixed_uint<64>().is_zero());
+		EXPECT_EQ(rsa::math::fixed_uint<64>(std::uint64_t{ 0x123456789u }).to_big_uint(), std::uint64_t{ 0x123456789u });
+		EXPECT_EQ(rsa::math::fixed_uint<64>(rsa::math::big_uint_32(0x42u)).data()[0], 0x42u);
+
+		EXPECT_THROW(rsa::math::fixed_uint<32>(std::uint64_t{ 0x123456789u }), std::range_error);
+		EXPECT_THROW(rsa::math::fixed_uint<32>(rsa::math::big_uint_32(std::uint64_t{ 0x123456789u })), std::range_error);
+		EXPECT_NO_THROW(rsa::math::fixed_uint<32>(rsa::math::big_uint_32(0xffffffffu)));
+	}
+
+	TEST(Test_RSA, math_fixed_uint_bits__Values)
+	{
+		auto a = rsa::math::fixed_uint<128, std::uint16_t>();
+
+		a.set_bit(127u, true);
+		a.set_bit(3u, true);
+		EXPECT_TRUE(a.get_bit(127u));
+		EXPECT_TRUE(a.get_bit(3u));
+		EXPECT_FALSE(a.get_bit(4u));
+
+		a.set_bit(3u, false);
+		EXPECT_FALSE(a.get_bit(3u));
+		EXPECT_EQ(a.to_big_uint(), rsa::math::big_uint_16(1u) <<= 127u);
+	}
+
+	TEST(Test_RSA, math_fixed_uint_operators__Wrap)
+	{
+		using fixed_t = rsa::math::fixed_uint<64, std::uint16_t>;
+
+		auto const max = fixed_t(rsa::math::utils::max<std::uint64_t>());
+		auto const one = fixed_t(1u);
+
+		EXPECT_TRUE((max + one).is_zero());
+		EXPECT_EQ(fixed_t() - one, max);
+		EXPECT_TRUE(one < max);
+		EXPECT_TRUE(max > one);
+	}
+
+	TEST(Test_RSA, math_fixed_uint_ops__MatchesBigUint)
+	{
+		auto rng = std::mt19937_64();
+
+		EXPECT_TRUE((test_fixed_uint_random<64, std::uint8_t>(rng, 50u)));
+		EXPECT_TRUE((test_fixed_uint_random<256, std::uint16_t>(rng, 50u)));
+		EXPECT_TRUE((test_fixed_uint_random<1024, std::uint32_t>(rng, 20u)));
+#if defined(__SIZEOF_INT128__)
+		EXPECT_TRUE((test_fixed_uint_random<2048, std::uint64_t>(rng, 10u)));
+#endif
+	}
+
+	TEST(Test_RSA, math_fixed_montgomery_constructor__ThrowsForEvenModulus)
+	{
+		using fixed_t = rsa::math::fixed_uint<64>;
+
+		EXPECT_THROW(rsa::math::fixed_montgomery_context<64>(fixed_t{ }), std::invalid_argument);
+		EXPECT_THROW(rsa::math::fixed_montgomery_context<64>(fixed_t{ 2u }), std::invalid_argument);
+		EXPECT_NO_THROW(rsa::math::fixed_montgomery_context<64>(fixed_t{ 1u }));
+	}
+
+	TEST(Test_RSA, math_fixed_montgomery_mul__MatchesMontgomeryContext)
+	{
+		auto rng = std::mt19937_64();
+
+		EXPECT_TRUE((test_fixed_montgomery_random<64, std::uint8_t>(rng, 50u)));
+		EXPECT_TRUE((test_fixed_montgomery_random<256, std::uint16_t>(rng, 50u)));
+		EXPECT_TRUE((test_fixed_montgomery_random<1024, std::uint32_t>(rng, 20u)));
+#if defined(__SIZEOF_INT128__)
+		EXPECT_TRUE((test_fixed_montgomery_random<2048, std::uint64_t>(rng, 10u)));
+#endif
+	}
+
+} // test
@@ -0,0 +1,121 @@
+#include "rsa_math__mod_pow.h"
+#include "rsa_math__primes.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+namespace test
+{
+
+	namespace
+	{
+
+		// right to left binary exponentiation, using only big_uint operators
+		template<class block_t>
+		rsa::math::big_uint<block_t> naive_mod_pow(rsa::math::big_uint<block_t> base, rsa::math::big_uint<block_t> exp, rsa::math::big_uint<block_t> const& mod)
+		{
+			auto result = rsa::math::big_uint<block_t>(1u) % mod;
+			base %= mod;
+
+			while (!exp.is_zero())
+			{
+				if (exp.get_bit(0u))
+					result = (result * base) % mod;
+
+				base = (base * base) % mod;
+				exp >>= 1u;
+			}
+
+			return result;
+		}
+
+		template<class block_t>
+		bool test_mod_pow_random(std::mt19937_64& rng, std::size_t mod_bits, std::size_t exp_bits, bool odd)
+		{
+			for (auto i = 0; i != 5; ++i)
+			{
+				auto mod = rsa::math::generate_random_bits<block_t>(rng, mod_bits);
+				mod.set_bit(0u, odd);
+
+				if (mod.is_zero())
+					continue;
+
+				auto const base = rsa::math::generate_random_bits<block_t>(rng, mod_bits + 4u);
+				auto const exp = rsa::math::generate_random_bits<block_t>(rng, exp_bits);
+
+				if (rsa::math::mod_pow(base, exp, mod) != naive_mod_pow(base, exp, mod))
+					return false;
+			}
+
+			return true;
+		}
+
+	} // unnamed
+
+	TEST(Test_RSA, math_mod_pow__ThrowsForZeroModulus)
+	{
+		EXPECT_THROW(rsa::math::mod_pow(rsa::math::big_uint_32(2u), rsa::math::big_uint_32(3u), rsa::math::big_uint_32()), std::invalid_argument);
+	}
+
+	TEST(Test_RSA, math_mod_pow__Value)
+	{
+		using n = rsa::math::big_uint_32;
+
+		EXPECT_EQ(rsa::math::mod_pow(n(2u), n(10u), n(1000u)), 24u);
+		EXPECT_EQ(rsa::math::mod_pow(n(2u), n(10u), n(1001u)), 23u);
+		EXPECT_EQ(rsa::math::mod_pow(n(4u), n(13u), n(497u)), 445u);
+		EXPECT_EQ(rsa::math::mod_pow(n(0u), n(5u), n(7u)), 0u);
+		EXPECT_EQ(rsa::math::mod_pow(n(0u), n(0u), n(7u)), 1u);
+		EXPECT_EQ(rsa::math::mod_pow(n(5u), n(0u), n(8u)), 1u);
+		EXPECT_EQ(rsa::math::mod_pow(n(5u), n(3u), n(1u)), 0u);
+		EXPECT_EQ(rsa::math::mod_pow(n(12u), n(1u), n(7u)), 5u);
+
+		// fermat's little theorem (2^127 - 1 is prime)
+		auto const p = (n(1u) <<= 127u) - 1u;
+		EXPECT_EQ(rsa::math::mod_pow(n(3u), p - 1u, p), 1u);
+	}
+
+	TEST(Test_RSA, math_mod_pow__MatchesNaive)
+	{
+		auto rng = std::mt19937_64();
+
+		for (auto bits : { 5u, 32u, 100u, 256u })
+		{
+			for (auto exp_bits : { 1u, 7u, 30u, 300u })
+			{
+				EXPECT_TRUE(test_mod_pow_random<std::uint8_t>(rng, bits, exp_bits, true));
+				EXPECT_TRUE(test_mod_pow_random<std::uint8_t>(rng, bits, exp_bits, false));
+				EXPECT_TRUE(test_mod_pow_random<std::uint32_t>(rng, bits, exp_bits, true));
+				EXPECT_TRUE(test_mod_pow_random<std::uint32_t>(rng, bits, exp_bits, false));
+#if defined(__SIZEOF_INT128__)
+				EXPECT_TRUE(test_mod_pow_random<std::uint64_t>(rng, bits, exp_bits, true));
+#endif
+			}
+		}
+
+		// large window sizes
+		EXPECT_TRUE(test_mod_pow_random<std::uint32_t>(rng, 512u, 2048u, true));
+		EXPECT_TRUE(test_mod_pow_random<std::uint32_t>(rng, 512u, 2048u, false));
+	}
+
+	TEST(Test_RSA, math_mod_pow_context__MatchesModPow)
+	{
+		auto rng = std::mt19937_64();
+
+		auto const n = rsa::math::generate_random_bits<std::uint32_t>(rng, 300u) | 1u;
+		auto const context = rsa::math::montgomery_context<std::uint32_t>(n);
+
+		for (auto exp_bits : { 0u, 1u, 7u, 300u })
+		{
+			auto const base = rsa::math::generate_random_bits<std::uint32_t>(rng, 290u);
+			auto const exp = rsa::math::generate_random_bits<std::uint32_t>(rng, exp_bits);
+
+			auto const result = rsa::math::mod_pow(context, context.to_montgomery(base), exp);
+			EXPECT_EQ(context.from_montgomery(result), rsa::math::mod_pow(base, exp, n));
+		}
+	}
+
+} // test
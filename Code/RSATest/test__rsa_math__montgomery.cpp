@@ -0,0 +1,111 @@
+#include "rsa_math__montgomery.h"
+#include "rsa_math__primes.h"
+#include "test_utils__uint_max.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+namespace test
+{
+
+	namespace
+	{
+
+		template<class block_t>
+		bool test_montgomery_random(std::mt19937_64& rng, std::size_t modulus_bits, std::size_t count)
+		{
+			auto modulus = rsa::math::generate_random_bits<block_t>(rng, modulus_bits);
+			modulus.set_bit(0u, true);
+
+			auto const context = rsa::math::montgomery_context<block_t>(modulus);
+
+			for (auto i = std::size_t{ 0 }; i != count; ++i)
+			{
+				auto const a = rsa::math::generate_random_bits<block_t>(rng, modulus_bits + 8u);
+				auto const b = rsa::math::generate_random_bits<block_t>(rng, modulus_bits);
+
+				auto const a_m = context.to_montgomery(a);
+				auto const b_m = context.to_montgomery(b);
+
+				if (context.from_montgomery(a_m) != a % modulus)
+					return false;
+
+				if (context.from_montgomery(context.mul(a_m, b_m)) != (a * b) % modulus)
+					return false;
+
+				if (context.from_montgomery(context.sqr(a_m)) != (a * a) % modulus)
+					return false;
+
+				// aliased
+				auto c = a_m;
+				context.mul_assign(c, c);
+
+				if (context.from_montgomery(c) != (a * a) % modulus)
+					return false;
+			}
+
+			return true;
+		}
+
+	} // unnamed
+
+	TEST(Test_RSA, math_montgomery_constructor__ThrowsForEvenModulus)
+	{
+		EXPECT_THROW(rsa::math::montgomery_context<std::uint32_t>(rsa::math::big_uint_32()), std::invalid_argument);
+		EXPECT_THROW(rsa::math::montgomery_context<std::uint32_t>(rsa::math::big_uint_32(2u)), std::invalid_argument);
+		EXPECT_THROW(rsa::math::montgomery_context<std::uint8_t>(rsa::math::big_uint_8(utils::uint32_max) + 1u), std::invalid_argument);
+		EXPECT_NO_THROW(rsa::math::montgomery_context<std::uint32_t>(rsa::math::big_uint_32(1u)));
+		EXPECT_NO_THROW(rsa::math::montgomery_context<std::uint32_t>(rsa::math::big_uint_32(3u)));
+	}
+
+	TEST(Test_RSA, math_montgomery_one)
+	{
+		auto const context = rsa::math::montgomery_context<std::uint16_t>(rsa::math::big_uint_16(utils::uint32_max));
+		EXPECT_EQ(context.from_montgomery(context.one()), 1u);
+		EXPECT_EQ(context.to_montgomery(rsa::math::big_uint_16(1u)), context.one());
+	}
+
+	TEST(Test_RSA, math_montgomery_mul__Value)
+	{
+		auto const n = rsa::math::big_uint_32(1000003u);
+		auto const context = rsa::math::montgomery_context<std::uint32_t>(n);
+
+		auto const a = context.to_montgomery(rsa::math::big_uint_32(123456u));
+		auto const b = context.to_montgomery(rsa::math::big_uint_32(654321u));
+
+		EXPECT_EQ(context.from_montgomery(context.mul(a, b)), (std::uint64_t{ 123456u } * 654321u) % 1000003u);
+		EXPECT_EQ(context.from_montgomery(context.sqr(a)), (std::uint64_t{ 123456u } * 123456u) % 1000003u);
+	}
+
+	TEST(Test_RSA, math_montgomery_mul__MatchesMod)
+	{
+		auto rng = std::mt19937_64();
+
+		for (auto bits : { 3u, 8u, 31u, 64u, 65u, 200u, 521u, 1024u })
+		{
+			EXPECT_TRUE(test_montgomery_random<std::uint8_t>(rng, bits, 10u));
+			EXPECT_TRUE(test_montgomery_random<std::uint16_t>(rng, bits, 10u));
+			EXPECT_TRUE(test_montgomery_random<std::uint32_t>(rng, bits, 10u));
+#if defined(__SIZEOF_INT128__)
+			EXPECT_TRUE(test_montgomery_random<std::uint64_t>(rng, bits, 10u));
+#endif
+		}
+	}
+
+	TEST(Test_RSA, math_montgomery_mul__MaxModulus)
+	{
+		// all bits set (largest possible intermediate values)
+		auto const n = rsa::math::big_uint_32(32u, utils::uint32_max);
+		auto const context = rsa::math::montgomery_context<std::uint32_t>(n);
+
+		auto const a = n - 1u;
+		auto const a_m = context.to_montgomery(a);
+
+		EXPECT_EQ(context.from_montgomery(context.mul(a_m, a_m)), (a * a) % n);
+		EXPECT_EQ(context.from_montgomery(context.sqr(a_m)), 1u);
+	}
+
+} // test
@@ -1,9 +1,12 @@
 
 #include "rsa_math__primes.h"
+#include "test_utils__counting_resource.h"
 
 #include <gtest/gtest.h>
 
+#include <memory_resource>
 #include <random>
+#include <vector>
 
 namespace test
 {
@@ -88,6 +91,254 @@ namespace test
 		}
 	}
 
+	TEST(Test_RSA, math_primes_is_probable_prime_rm__MatchesIsPrime)
+	{
+		auto rng = std::mt19937_64();
+		auto ws = rsa::math::workspace<std::uint32_t>();
+
+		for (auto n = 0u; n < 3000u; ++n)
+		{
+			auto const expected = n >= 2u && rsa::math::is_prime(std::uint64_t{ n });
+			EXPECT_EQ(rsa::math::is_probable_prime_rm(rsa::math::big_uint_32(n), rng, 10u), expected) << n;
+			EXPECT_EQ(rsa::math::is_probable_prime_rm(rsa::math::big_uint_32(n), rng, 10u, ws, true), expected) << n;
+		}
+
+		// (a product of primes above 2^16, which trial division wouldn't find)
+		auto const p = rsa::math::big_uint_32(65537u);
+		auto const q = rsa::math::big_uint_32(65539u);
+		EXPECT_TRUE(rsa::math::is_probable_prime_rm(q, rng, 10u));
+		EXPECT_FALSE(rsa::math::is_probable_prime_rm(p * q, rng, 10u));
+		EXPECT_TRUE(rsa::math::is_probable_prime_rm(q, rng, 1u, ws, true));
+		EXPECT_FALSE(rsa::math::is_probable_prime_rm(p * q, rng, 1u, ws, true));
+	}
+
+	TEST(Test_RSA, math_primes_is_strong_probable_prime__Values)
+	{
+		auto const bases = std::vector<std::uint32_t>{ 2u, 3u, 5u, 7u };
+
+		// (deterministic for n < 3215031751 with these bases)
+		EXPECT_FALSE(rsa::math::is_strong_probable_prime(rsa::math::big_uint_32(0u), bases));
+		EXPECT_FALSE(rsa::math::is_strong_probable_prime(rsa::math::big_uint_32(1u), bases));
+
+		for (auto n = std::uint32_t{ 2 }; n != 5000u; ++n)
+			EXPECT_EQ(rsa::math::is_strong_probable_prime(rsa::math::big_uint_32(n), bases), rsa::math::is_prime(n)) << n;
+
+		// strong pseudoprimes
+		EXPECT_TRUE(rsa::math::is_strong_probable_prime(rsa::math::big_uint_32(2047u), std::vector<std::uint32_t>{ 2u }));
+		EXPECT_FALSE(rsa::math::is_strong_probable_prime(rsa::math::big_uint_32(2047u), std::vector<std::uint32_t>{ 2u, 3u }));
+		EXPECT_TRUE(rsa::math::is_strong_probable_prime(rsa::math::big_uint_32(3215031751u), bases));
+		EXPECT_FALSE(rsa::math::is_strong_probable_prime(rsa::math::big_uint_32(3215031751u), std::vector<std::uint32_t>{ 2u, 3u, 5u, 7u, 11u }));
+
+		// carmichael numbers
+		for (auto const n : { 561u, 41041u, 825265u })
+			EXPECT_FALSE(rsa::math::is_strong_probable_prime(rsa::math::big_uint_8(n), bases)) << n;
+
+		// big bases, 2^127 - 1 and a product of two primes
+		auto const m127 = (rsa::math::big_uint_32(1u) <<= 127u) - 1u;
+		auto const big_bases = std::vector<rsa::math::big_uint_32>{ m127 - 2u, m127 + 2u, rsa::math::big_uint_32(123456789u) };
+		EXPECT_TRUE(rsa::math::is_strong_probable_prime(m127, big_bases));
+		EXPECT_FALSE(rsa::math::is_strong_probable_prime(m127 * 65537u, big_bases));
+
+		auto const rounds = rsa::math::miller_rabin<std::uint32_t>(m127);
+		EXPECT_EQ(rounds.n(), m127);
+		EXPECT_TRUE(rounds.test(rsa::math::big_uint_32(3u)));
+		EXPECT_TRUE(rounds.test_base_2());
+	}
+
+	TEST(Test_RSA, math_primes_miller_rabin_test_base_2__MatchesTest)
+	{
+		auto rng = std::mt19937_64();
+		auto const two = rsa::math::big_uint_32(2u);
+
+		for (auto n = 5u; n < 3000u; n += 2u)
+		{
+			auto const rounds = rsa::math::miller_rabin<std::uint32_t>(rsa::math::big_uint_32(n));
+			EXPECT_EQ(rounds.test_base_2(), rounds.test(two)) << n;
+		}
+
+		for (auto const bits : { 64u, 100u, 512u })
+		{
+			for (auto i = 0u; i != 20u; ++i)
+			{
+				auto n = rsa::math::generate_random_bits<std::uint32_t>(rng, bits);
+				n.set_bit(0u, true);
+				n.set_bit(bits - 1u, true);
+
+				auto const rounds = rsa::math::miller_rabin<std::uint32_t>(n);
+				EXPECT_EQ(rounds.test_base_2(), rounds.test(two));
+			}
+		}
+
+		auto const p = rsa::math::generate_prime_bpsw<std::uint8_t>(rng, 200u);
+		EXPECT_TRUE(rsa::math::miller_rabin<std::uint8_t>(p).test_base_2());
+		EXPECT_TRUE(rsa::math::miller_rabin<std::uint32_t>(rsa::math::big_uint_32(2047u)).test_base_2());
+		EXPECT_FALSE(rsa::math::miller_rabin<std::uint32_t>(rsa::math::big_uint_32(561u)).test_base_2());
+	}
+
+	TEST(Test_RSA, math_primes_jacobi__Values)
+	{
+		// (a / p) = a^((p - 1) / 2) mod p for odd primes p, and the product over the factors of n otherwise
+		auto const legendre = [] (std::int64_t a, std::uint64_t p)
+		{
+			auto const r = std::uint64_t(((a % std::int64_t(p)) + std::int64_t(p)) % std::int64_t(p));
+			auto x = std::uint64_t{ 1 };
+
+			for (auto i = std::uint64_t{ 0 }; i != (p - 1u) / 2u; ++i)
+				x = (x * r) % p;
+
+			return (x == 0u) ? 0 : (x == 1u) ? 1 : -1;
+		};
+
+		auto const jacobi = [&] (std::int64_t a, std::uint64_t n)
+		{
+			auto result = 1;
+
+			for (auto p = std::uint64_t{ 3 }; n != 1u; p += 2u)
+				while (n % p == 0u)
+				{
+					result *= legendre(a, p);
+					n /= p;
+				}
+
+			return result;
+		};
+
+		for (auto n = std::uint64_t{ 1 }; n < 400u; n += 2u)
+			for (auto a = std::int64_t{ -30 }; a != 30; ++a)
+			{
+				EXPECT_EQ(rsa::math::jacobi(a, rsa::math::big_uint_32(n)), jacobi(a, n)) << a << " " << n;
+				EXPECT_EQ(rsa::math::jacobi(a, rsa::math::big_uint_8(n)), jacobi(a, n)) << a << " " << n;
+			}
+
+		auto const big = (rsa::math::big_uint_32(1u) <<= 127u) - 1u;
+		EXPECT_EQ(rsa::math::jacobi(5, big), -1);
+		EXPECT_EQ(rsa::math::jacobi(-1, big), -1);
+		EXPECT_EQ(rsa::math::jacobi(2, big), 1);
+	}
+
+	TEST(Test_RSA, math_primes_is_square__Values)
+	{
+		for (auto n = 0u; n != 2000u; ++n)
+		{
+			auto root = 0u;
+			while ((root + 1u) * (root + 1u) <= n)
+				++root;
+
+			EXPECT_EQ(rsa::math::is_square(rsa::math::big_uint_16(n)), root * root == n) << n;
+		}
+
+		auto const big = rsa::math::big_uint_32({ 0x12345679u, 0xabcdef01u, 0x13579bdfu });
+		EXPECT_TRUE(rsa::math::is_square(big * big));
+		EXPECT_FALSE(rsa::math::is_square(big * big + 1u));
+		EXPECT_FALSE(rsa::math::is_square(big * big - 1u));
+		EXPECT_FALSE(rsa::math::is_square(big * (big + 2u)));
+	}
+
+	TEST(Test_RSA, math_primes_is_prime_bpsw__Values)
+	{
+		// (only trial divide by 2, so the other tests decide)
+		for (auto const primes : { std::size_t{ 1 }, std::size_t{ 0 } })
+		{
+			auto const scoped_primes = rsa::math::scoped_trial_division_primes(primes);
+
+			EXPECT_FALSE(rsa::math::is_prime_bpsw(rsa::math::big_uint_32(0u)));
+			EXPECT_FALSE(rsa::math::is_prime_bpsw(rsa::math::big_uint_32(1u)));
+
+			for (auto n = std::uint32_t{ 2 }; n != 5000u; ++n)
+			{
+				EXPECT_EQ(rsa::math::is_prime_bpsw(rsa::math::big_uint_32(n)), rsa::math::is_prime(n)) << n;
+				EXPECT_EQ(rsa::math::is_strong_lucas_probable_prime(rsa::math::big_uint_32(n)) || !rsa::math::is_prime(n), true) << n;
+			}
+		}
+
+		// strong lucas pseudoprimes (which aren't base 2 strong pseudoprimes)
+		for (auto const n : { 5459u, 5777u, 10877u, 16109u, 18971u })
+		{
+			EXPECT_TRUE(rsa::math::is_strong_lucas_probable_prime(rsa::math::big_uint_32(n))) << n;
+			EXPECT_FALSE(rsa::math::is_prime_bpsw(rsa::math::big_uint_32(n))) << n;
+		}
+
+		// base 2 strong pseudoprimes
+		for (auto const n : { 2047u, 3277u, 4033u, 3215031751u })
+			EXPECT_FALSE(rsa::math::is_prime_bpsw(rsa::math::big_uint_32(n))) << n;
+
+		auto const m89 = (rsa::math::big_uint_32(1u) <<= 89u) - 1u;
+		auto const m127 = (rsa::math::big_uint_32(1u) <<= 127u) - 1u;
+		EXPECT_TRUE(rsa::math::is_prime_bpsw(m89));
+		EXPECT_TRUE(rsa::math::is_prime_bpsw(m127));
+		EXPECT_FALSE(rsa::math::is_prime_bpsw(m89 * m127));
+		EXPECT_FALSE(rsa::math::is_prime_bpsw(m127 * m127));
+		EXPECT_TRUE(rsa::math::is_prime_bpsw((rsa::math::big_uint_64(1u) <<= 127u) - 1u));
+	}
+
+	TEST(Test_RSA, math_primes_sieve_candidates__MarksComposites)
+	{
+		// (the sieve only uses the primes less than the start of the range)
+		auto const has_small_factor = [] (std::uint64_t start, std::uint64_t n)
+		{
+			for (auto p = std::uint64_t{ 3 }; p < 65536u && p < start; p += 2u)
+				if (n % p == 0u)
+					return true;
+
+			return false;
+		};
+
+		auto rng = std::mt19937_64();
+
+		for (auto const bits : { 2u, 9u, 17u, 40u, 63u })
+		{
+			auto start = rsa::math::generate_random_bits<std::uint32_t>(rng, bits);
+			start.set_bit(0u, true);
+			start.set_bit(bits - 1u, true);
+
+			auto composite = std::pmr::vector<bool>(200u, false);
+			rsa::math::sieve_candidates(composite, start);
+
+			auto const s = start.to_uint<std::uint64_t>();
+
+			for (auto i = std::size_t{ 0 }; i != composite.size(); ++i)
+				EXPECT_EQ(composite[i], has_small_factor(s, s + 2u * i)) << s + 2u * i;
+		}
+	}
+
+	TEST(Test_RSA, math_primes_find_small_factor__Values)
+	{
+		auto const smallest_factor = [] (std::uint64_t n, std::uint64_t limit)
+		{
+			for (auto p = std::uint64_t{ 2 }; p <= limit; ++p)
+				if (n % p == 0u && rsa::math::is_prime(p))
+					return std::uint32_t(p);
+
+			return std::uint32_t{ 0 };
+		};
+
+		auto rng = std::mt19937_64();
+
+		for (auto i = 0u; i != 200u; ++i)
+		{
+			auto const n = (i < 20u) ? std::uint64_t{ i } + 1u : rng();
+			auto const count = std::size_t(rng() % 300u);
+			auto const limit = (count == 0u) ? 0u : (count == 1u) ? 2u : rsa::math::sieve_primes()[count - 2u];
+			auto const expected = smallest_factor(n, limit);
+
+			EXPECT_EQ(rsa::math::find_small_factor<std::uint8_t>(rsa::math::big_uint_8(n), count), expected) << n << " " << count;
+			EXPECT_EQ(rsa::math::find_small_factor<std::uint16_t>(rsa::math::big_uint_16(n), count), expected) << n << " " << count;
+			EXPECT_EQ(rsa::math::find_small_factor<std::uint32_t>(rsa::math::big_uint_32(n), count), expected) << n << " " << count;
+			EXPECT_EQ(rsa::math::find_small_factor<std::uint64_t>(rsa::math::big_uint_64(n), count), expected) << n << " " << count;
+		}
+
+		auto const big = rsa::math::big_uint_32({ 0x0u, 0x0u, 0x1u }) * 65521u;
+		EXPECT_EQ(rsa::math::find_small_factor<std::uint32_t>(big * 3u, 10000u), 2u);
+		EXPECT_EQ(rsa::math::find_small_factor<std::uint32_t>((big >> 64u) * 65519u, 10000u), 65519u);
+
+		auto const scoped_primes = rsa::math::scoped_trial_division_primes(0u);
+		EXPECT_EQ(rsa::math::trial_division_prime_count(64u), 300u);
+		EXPECT_EQ(rsa::math::trial_division_prime_count(1024u), 1536u);
+		EXPECT_EQ(rsa::math::trial_division_prime_count(4096u), 3000u);
+		rsa::math::trial_division_primes() = 25u;
+		EXPECT_EQ(rsa::math::trial_division_prime_count(4096u), 25u);
+	}
+
 	TEST(Test_RSA, math_primes_generate_prime__ReturnsPrime)
 	{
 		auto k = 20u;
@@ -116,4 +367,35 @@ namespace test
 		// larger numbers are slow in release too... :(
 	}
 
+	TEST(Test_RSA, math_primes_generate_prime_bpsw__ReturnsPrime)
+	{
+		auto rng = std::mt19937_64();
+
+		for (auto const bits : { 3u, 16u, 24u, 64u, 256u })
+		{
+			auto const p = rsa::math::generate_prime_bpsw<std::uint32_t>(rng, bits);
+			EXPECT_EQ(p.get_most_significant_bit() + 1u, bits);
+			EXPECT_TRUE(rsa::math::is_prime_rm(p, rng, 20u));
+		}
+	}
+
+	TEST(Test_RSA, math_primes_generate_prime_rm__UsesAllocator)
+	{
+		auto k = 10u;
+		auto rng = std::mt19937_64();
+
+		auto arena = utils::counting_resource();
+		auto default_resource = utils::counting_resource();
+		auto const scoped_default = utils::scoped_default_resource(&default_resource);
+
+		auto const p = rsa::math::generate_prime_rm<std::uint32_t>(rng, 256u, k, rsa::math::default_workspace<std::uint32_t>(), &arena);
+
+		EXPECT_EQ(p.get_allocator().resource(), &arena);
+		EXPECT_NE(arena.allocations(), 0u);
+		EXPECT_EQ(default_resource.allocations(), 0u);
+
+		EXPECT_TRUE(rsa::math::is_prime_rm(p, rng, k));
+		EXPECT_EQ(default_resource.allocations(), 0u);
+	}
+
 } // test
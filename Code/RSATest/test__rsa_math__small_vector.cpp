@@ -0,0 +1,176 @@
+#include "rsa_math__small_vector.h"
+#include "rsa_math__big_uint.h"
+#include "test_utils__counting_resource.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace test
+{
+
+	namespace
+	{
+
+		using small_vector_t = rsa::math::small_vector<std::uint32_t, 4u>;
+
+		template<class vector_t>
+		bool equals(vector_t const& a, std::vector<std::uint32_t> const& b)
+		{
+			return std::vector<std::uint32_t>(a.begin(), a.end()) == b;
+		}
+
+	} // unnamed
+
+	TEST(Test_RSA, math_small_vector_push_back__SpillsToHeap)
+	{
+		auto v = small_vector_t();
+		EXPECT_TRUE(v.empty());
+		EXPECT_TRUE(v.is_inline());
+		EXPECT_EQ(v.capacity(), 4u);
+
+		for (auto i = 0u; i != 4u; ++i)
+			v.push_back(i);
+
+		EXPECT_TRUE(v.is_inline());
+
+		v.push_back(4u);
+		EXPECT_FALSE(v.is_inline());
+		EXPECT_GE(v.capacity(), 5u);
+		EXPECT_TRUE(equals(v, { 0u, 1u, 2u, 3u, 4u }));
+
+		// (capacity is kept when shrinking)
+		v.resize(1u);
+		EXPECT_FALSE(v.is_inline());
+		EXPECT_TRUE(equals(v, { 0u }));
+
+		v.resize(3u, 7u);
+		EXPECT_TRUE(equals(v, { 0u, 7u, 7u }));
+
+		v.pop_back();
+		EXPECT_EQ(v.back(), 7u);
+		EXPECT_EQ(v.size(), 2u);
+	}
+
+	TEST(Test_RSA, math_small_vector_insert_erase__Values)
+	{
+		auto v = small_vector_t{ 1u, 2u, 3u };
+
+		v.insert(v.begin(), 2u, 0u);
+		EXPECT_TRUE(equals(v, { 0u, 0u, 1u, 2u, 3u }));
+
+		auto const tail = std::vector<std::uint32_t>{ 8u, 9u };
+		v.insert(v.end(), tail.begin(), tail.end());
+		EXPECT_TRUE(equals(v, { 0u, 0u, 1u, 2u, 3u, 8u, 9u }));
+
+		v.insert(v.begin() + 3, 5u);
+		EXPECT_TRUE(equals(v, { 0u, 0u, 1u, 5u, 2u, 3u, 8u, 9u }));
+
+		v.erase(v.begin(), v.begin() + 2);
+		EXPECT_TRUE(equals(v, { 1u, 5u, 2u, 3u, 8u, 9u }));
+
+		v.erase(v.begin() + 1);
+		EXPECT_TRUE(equals(v, { 1u, 2u, 3u, 8u, 9u }));
+
+		v.erase(v.begin() + 3, v.end());
+		EXPECT_TRUE(equals(v, { 1u, 2u, 3u }));
+
+		v.push_back(v[0]);
+		v.push_back(v[1]);
+		EXPECT_TRUE(equals(v, { 1u, 2u, 3u, 1u, 2u }));
+	}
+
+	TEST(Test_RSA, math_small_vector_copy_move_swap__Values)
+	{
+		auto const small = small_vector_t{ 1u, 2u };
+		auto const large = small_vector_t{ 1u, 2u, 3u, 4u, 5u, 6u };
+
+		for (auto const& a : { small, large })
+		{
+			for (auto const& b : { small, large })
+			{
+				auto const a_values = std::vector<std::uint32_t>(a.begin(), a.end());
+				auto const b_values = std::vector<std::uint32_t>(b.begin(), b.end());
+
+				auto x = a;
+				auto y = b;
+				EXPECT_TRUE(x == a);
+
+				x.swap(y);
+				EXPECT_TRUE(equals(x, b_values));
+				EXPECT_TRUE(equals(y, a_values));
+
+				x = y;
+				EXPECT_TRUE(equals(x, a_values));
+
+				y = std::move(x);
+				EXPECT_TRUE(equals(y, a_values));
+
+				auto z = std::move(y);
+				EXPECT_TRUE(equals(z, a_values));
+
+				// (moved from vectors are still usable)
+				x.assign(b.begin(), b.end());
+				EXPECT_TRUE(equals(x, b_values));
+			}
+		}
+
+		EXPECT_TRUE(small < large);
+		EXPECT_FALSE(large < small);
+		EXPECT_TRUE(small != large);
+	}
+
+	TEST(Test_RSA, math_small_vector_allocator__Propagation)
+	{
+		using pmr_vector_t = rsa::math::small_vector<std::uint32_t, 4u, std::pmr::polymorphic_allocator<std::uint32_t>>;
+
+		auto resource_a = utils::counting_resource();
+		auto resource_b = utils::counting_resource();
+
+		auto a = pmr_vector_t({ 1u, 2u, 3u, 4u, 5u, 6u }, &resource_a);
+		EXPECT_EQ(resource_a.allocations(), 1u);
+
+		// (copy assignment keeps the allocator)
+		auto b = pmr_vector_t(&resource_b);
+		b = a;
+		EXPECT_EQ(b.get_allocator().resource(), &resource_b);
+		EXPECT_EQ(resource_b.allocations(), 1u);
+		EXPECT_TRUE(equals(b, { 1u, 2u, 3u, 4u, 5u, 6u }));
+
+		// (move construction takes the buffer and the allocator)
+		auto c = std::move(a);
+		EXPECT_EQ(c.get_allocator().resource(), &resource_a);
+		EXPECT_EQ(resource_a.allocations(), 1u);
+		EXPECT_FALSE(c.is_inline());
+
+		// (move assignment with a different allocator copies)
+		c.push_back(7u);
+		b = std::move(c);
+		EXPECT_EQ(b.get_allocator().resource(), &resource_b);
+		EXPECT_TRUE(equals(b, { 1u, 2u, 3u, 4u, 5u, 6u, 7u }));
+
+		auto const d = pmr_vector_t(b, &resource_a);
+		EXPECT_EQ(d.get_allocator().resource(), &resource_a);
+		EXPECT_TRUE(d == b);
+	}
+
+#if (RSA_MATH_BIG_UINT_INLINE_BLOCKS >= 2)
+
+	TEST(Test_RSA, math_small_vector_big_uint__SmallValuesInline)
+	{
+		auto const a = rsa::math::big_uint_32(std::uint64_t{ 0x123456789abcdef0u });
+		EXPECT_TRUE(a.data().is_inline());
+
+		auto b = a;
+		b *= a;
+		b %= rsa::math::big_uint_32(std::uint64_t{ 0xfedcba987654321u });
+		EXPECT_TRUE(b.data().is_inline());
+		EXPECT_EQ(b, std::uint64_t{ 0x1f3526859b8cfe6u });
+	}
+
+#endif
+
+} // test
@@ -0,0 +1,125 @@
+#include "rsa_math__workspace.h"
+#include "rsa_math__mod_pow.h"
+#include "rsa_math__primes.h"
+#include "test_utils__scoped_thresholds.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+namespace test
+{
+
+	TEST(Test_RSA, math_workspace_frame__ReleasesInReverseOrder)
+	{
+		auto ws = rsa::math::workspace<std::uint32_t>();
+		EXPECT_EQ(ws.capacity(), 0u);
+
+		{
+			auto outer = rsa::math::workspace<std::uint32_t>::frame(ws);
+			auto const a = outer.allocate(10u);
+
+			EXPECT_TRUE(std::all_of(a, a + 10u, [] (std::uint32_t b) { return b == 0u; }));
+			std::fill(a, a + 10u, 1u);
+
+			auto inner_first = static_cast<std::uint32_t*>(nullptr);
+
+			{
+				auto inner = rsa::math::workspace<std::uint32_t>::frame(ws);
+				inner_first = inner.allocate(5u);
+
+				EXPECT_NE(inner_first, a);
+				std::fill(inner_first, inner_first + 5u, 2u);
+			}
+
+			// the inner frame's memory is reused (and zeroed again)
+			{
+				auto inner = rsa::math::workspace<std::uint32_t>::frame(ws);
+				auto const b = inner.allocate(5u);
+
+				EXPECT_EQ(b, inner_first);
+				EXPECT_TRUE(std::all_of(b, b + 5u, [] (std::uint32_t x) { return x == 0u; }));
+			}
+
+			// the outer frame's memory is unaffected
+			EXPECT_TRUE(std::all_of(a, a + 10u, [] (std::uint32_t x) { return x == 1u; }));
+		}
+	}
+
+	TEST(Test_RSA, math_workspace_frame__GrowsAndMerges)
+	{
+		auto ws = rsa::math::workspace<std::uint16_t>();
+
+		{
+			auto frame = rsa::math::workspace<std::uint16_t>::frame(ws);
+			auto const a = frame.allocate(200u);
+			auto const b = frame.allocate(1000u); // (doesn't fit in the first chunk)
+
+			// earlier allocations stay valid
+			a[199] = 1u;
+			b[999] = 2u;
+			EXPECT_EQ(a[199], 1u);
+		}
+
+		auto const capacity = ws.capacity();
+		EXPECT_GE(capacity, 1200u);
+
+		// once merged, the same allocations fit without growing
+		{
+			auto frame = rsa::math::workspace<std::uint16_t>::frame(ws);
+			frame.allocate(200u);
+			frame.allocate(1000u);
+		}
+
+		EXPECT_EQ(ws.capacity(), capacity);
+	}
+
+	TEST(Test_RSA, math_workspace_mod_pow__CapacityStable)
+	{
+		auto rng = std::mt19937_64();
+
+		auto& thresholds = rsa::math::ops::thresholds();
+		auto const scoped_thresholds = utils::scoped_thresholds();
+
+		// (small thresholds, so karatsuba, toom-3 and burnikel-ziegler all take memory from the workspace)
+		thresholds = { 4u, 9u, thresholds.ntt, 2u };
+
+		auto ws = rsa::math::workspace<std::uint16_t>();
+
+		for (auto const odd : { true, false })
+		{
+			auto mod = rsa::math::generate_random_bits<std::uint16_t>(rng, 640u);
+			mod.set_bit(0u, odd);
+			mod.set_bit(639u, true);
+
+			auto const base = rsa::math::generate_random_bits<std::uint16_t>(rng, 1400u);
+			auto const exp = rsa::math::generate_random_bits<std::uint16_t>(rng, 64u);
+
+			auto const expected = rsa::math::mod_pow(base, exp, mod);
+
+			EXPECT_EQ(rsa::math::mod_pow(base, exp, mod, ws), expected);
+			auto const capacity = ws.capacity();
+
+			EXPECT_EQ(rsa::math::mod_pow(base, exp, mod, ws), expected);
+			EXPECT_EQ(ws.capacity(), capacity);
+		}
+	}
+
+	TEST(Test_RSA, math_workspace_is_prime_rm__MatchesDefault)
+	{
+		auto ws = rsa::math::workspace<std::uint32_t>();
+
+		auto rng_a = std::mt19937_64();
+		auto rng_b = std::mt19937_64();
+
+		auto const p = rsa::math::generate_prime_rm<std::uint32_t>(rng_a, 256u, 10u, ws);
+		auto const q = rsa::math::generate_prime_rm<std::uint32_t>(rng_b, 256u, 10u);
+
+		EXPECT_EQ(p, q);
+		EXPECT_TRUE(rsa::math::is_prime_rm(p, rng_a, 10u, ws));
+		EXPECT_FALSE(rsa::math::is_prime_rm(p * q, rng_a, 10u, ws));
+	}
+
+} // test
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace test
+{
+
+	namespace utils
+	{
+
+		// a memory resource that counts the allocations made through it (passing them on to upstream).
+		class counting_resource : public std::pmr::memory_resource
+		{
+		public:
+
+			explicit counting_resource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()):
+				m_upstream(upstream),
+				m_allocations(0u)
+			{
+
+			}
+
+			std::size_t allocations() const
+			{
+				return m_allocations;
+			}
+
+		private:
+
+			void* do_allocate(std::size_t bytes, std::size_t alignment) override
+			{
+				++m_allocations;
+				return m_upstream->allocate(bytes, alignment);
+			}
+
+			void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+			{
+				m_upstream->deallocate(p, bytes, alignment);
+			}
+
+			bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+			{
+				return (this == &other);
+			}
+
+			std::pmr::memory_resource* m_upstream;
+			std::size_t m_allocations;
+		};
+
+		// replaces the default memory resource until destroyed.
+		class scoped_default_resource
+		{
+		public:
+
+			explicit scoped_default_resource(std::pmr::memory_resource* resource):
+				m_previous(std::pmr::set_default_resource(resource))
+			{
+
+			}
+
+			scoped_default_resource(scoped_default_resource const&) = delete;
+			scoped_default_resource& operator=(scoped_default_resource const&) = delete;
+
+			~scoped_default_resource()
+			{
+				std::pmr::set_default_resource(m_previous);
+			}
+
+		private:
+
+			std::pmr::memory_resource* m_previous;
+		};
+
+	} // utils
+
+} // test
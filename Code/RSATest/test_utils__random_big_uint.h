@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace test
+{
+
+	namespace utils
+	{
+
+		// a big_uint_t of the given number of random blocks (the last block is made odd, so none are trimmed).
+		template<class big_uint_t>
+		big_uint_t random_big_uint(std::mt19937_64& rng, std::size_t blocks)
+		{
+			using block_t = typename big_uint_t::block_type;
+
+			auto n = big_uint_t();
+			n.data().resize(blocks);
+			std::generate(n.data().begin(), n.data().end(), [&] () { return static_cast<block_t>(rng()); });
+
+			if (!n.data().empty())
+				n.data().back() |= 1u;
+
+			return n;
+		}
+
+		// as random_big_uint, with the blocks biased towards all zero or all one bits (for carries, borrows and division corrections).
+		template<class big_uint_t>
+		big_uint_t random_big_uint_biased(std::mt19937_64& rng, std::size_t blocks)
+		{
+			using block_t = typename big_uint_t::block_type;
+
+			auto dist = std::uniform_int_distribution<int>(0, 3);
+
+			auto n = big_uint_t();
+			n.data().resize(blocks);
+
+			for (auto& block : n.data())
+			{
+				auto const type = dist(rng);
+				block = (type == 0) ? block_t{ 0 } : (type == 1) ? std::numeric_limits<block_t>::max() : static_cast<block_t>(rng());
+			}
+
+			if (!n.data().empty())
+				n.data().back() |= 1u;
+
+			return n;
+		}
+
+	} // utils
+
+} // test
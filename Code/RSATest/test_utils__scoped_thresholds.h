@@ -0,0 +1,43 @@
+#pragma once
+
+#include "rsa_math_ops__multiplication.h"
+
+namespace test
+{
+
+	namespace utils
+	{
+
+		// restores the arithmetic thresholds (rsa::math::ops::thresholds()) to their values at construction when destroyed,
+		// so tests can change them freely.
+		class scoped_thresholds
+		{
+		public:
+
+			scoped_thresholds():
+				m_previous(rsa::math::ops::thresholds())
+			{
+
+			}
+
+			scoped_thresholds(scoped_thresholds const&) = delete;
+			scoped_thresholds& operator=(scoped_thresholds const&) = delete;
+
+			~scoped_thresholds()
+			{
+				rsa::math::ops::thresholds() = m_previous;
+			}
+
+			rsa::math::ops::thresholds_type const& previous() const
+			{
+				return m_previous;
+			}
+
+		private:
+
+			rsa::math::ops::thresholds_type m_previous;
+		};
+
+	} // utils
+
+} // test